@@ -1,17 +1,22 @@
 #include "Board.h"
 
-#include <future>
-
 #include "MyPlayerController.h"
 #include "PaperSpriteComponent.h"
-#include "Solver.h"
-#include "Worker.h"
+#include "GomokuCore/Solver.h"
+#include "GomokuCore/ThreadPool.h"
 #include "Camera/CameraActor.h"
 #include "Camera/CameraComponent.h"
 
 ABoard::ABoard()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	NumSolvers = 0;
+	NumThreadsPerSolver = 1;
+	Ponder = true;
+	SearchMemoryMB = 512;
+	SymmetricTranspositions = true;
+	SearchThreads = nullptr;
+	IsSolving = false;
 }
 
 void ABoard::BeginPlay()
@@ -24,6 +29,9 @@ void ABoard::BeginPlay()
 	
 	BoardActors.Init(nullptr, BoardSize * BoardSize);
 
+	// every solver searches on a pool thread and its helpers take the others
+	SearchThreads = new ThreadPool(GetNumSolvers() * FMath::Max(NumThreadsPerSolver, 1));
+
 	Initialize(3, false);
 	
 	const int32 boardWidth = BoardSize * (SpriteSize + SpriteMargin);
@@ -37,23 +45,54 @@ void ABoard::Tick(float DeltaSeconds)
 {
 	if(TurnStone != PlayersStone)
 	{
-		const int32 move = TryGetSolution();
-		if(move != -1)
+		int32 move;
+		if(!TryGetSolution(move))
 		{
-			PlaceStone(move, TurnStone);
-			if(IsWinningMove(move, AIsStone))
-			{
-				LastPlacedStone->GetRenderComponent()->SetSpriteColor(FLinearColor(1, 0, 0));
-				PlayerController->ShowEndUI(false);
-			}
+			return;
+		}
+
+		if(move == -1)
+		{
+			UE_LOG(LogTemp, Error, TEXT("the solvers found no move"));
+			return;
+		}
+		
+		PlaceStone(move, TurnStone);
+		if(IsWinningMove(move, AIsStone))
+		{
+			LastPlacedStone->GetRenderComponent()->SetSpriteColor(FLinearColor(1, 0, 0));
+			PlayerController->ShowEndUI(false);
+		}
+		else if(Ponder && NumFullSpaces < Board.size())
+		{
+			StartPondering(move);
 		}
 	}
 }
 
+void ABoard::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// waits for a running search before the solvers go away
+	StopSearching();
+	delete SearchThreads;
+	SearchThreads = nullptr;
+
+	for (auto gomokuSolver : GomokuSolvers)
+	{
+		delete gomokuSolver;
+	}
+	GomokuSolvers.clear();
+}
+
 void ABoard::Initialize(int32 DifficultyLevel, bool PlayFirstMove)
 {
 	IterationsToSolve = Difficulties[DifficultyLevel];
 	TimeToSolve = DifficultyLevel * 2;
+
+	StopSearching();
+	IsSolving = false;
 	
 	for (auto gomokuSolver : GomokuSolvers)
 	{
@@ -61,7 +100,6 @@ void ABoard::Initialize(int32 DifficultyLevel, bool PlayFirstMove)
 	}
 
 	GomokuSolvers.clear();
-	Solutions.clear();
 	
 	Board = std::vector<EStoneType>(BoardSize * BoardSize, EStoneType::Empty);
 	
@@ -130,90 +168,95 @@ void ABoard::PlaceStone(int32 index, EStoneType stoneType)
 
 void ABoard::Solve(int32 fromAction)
 {
-	Solutions.clear();
-	
 	if(GomokuSolvers.size() == 0)
 	{
-		for (int i = 0; i < 2; ++i)
+		for (int i = 0; i < GetNumSolvers(); ++i)
 		{
 			Solver* solver = new Solver(TimeToSolve, IterationsToSolve);
+			solver->SetThreadPool(SearchThreads, NumThreadsPerSolver);
+			solver->SetMemoryBudget(GetSolverMemoryMB());
+			solver->SetUseSymmetry(SymmetricTranspositions);
 			GomokuSolvers.push_back(solver);
 		}
 	}
+
+	const int32 numCells = Board.size();
+	// cells a solver did not evaluate keep a negative visit count
+	SolverEvaluations.assign(GomokuSolvers.size() * numCells, Evaluation{-1, 0});
+	IsSolving = true;
 	
-	for (const auto& solver : GomokuSolvers)
+	for (int32 i = 0; i < (int32)GomokuSolvers.size(); ++i)
 	{
-		Worker* worker = new Worker(solver, Board, TurnStone, fromAction);
-		Workers.push_back(worker);
+		Solver* solver = GomokuSolvers[i];
+		Evaluation* evaluations = &SolverEvaluations[i * numCells];
+		
+		SearchThreads->Submit([solver, evaluations, board = Board, turnStone = TurnStone, fromAction]() mutable
+		{
+			for (const auto& edge : solver->Run(board, turnStone, fromAction))
+			{
+				evaluations[edge.first] = edge.second;
+			}
+		});
 	}
 }
 
-int32 ABoard::TryGetSolution()
+void ABoard::StartPondering(int32 fromAction)
 {
-	if(Workers.size() == 0)
-	{
-		return -1;
-	}
-	for (const auto worker : Workers)
+	for (const auto solver : GomokuSolvers)
 	{
-		if(!worker->GetIsDone())
-			return -1;
+		SearchThreads->Submit([solver, board = Board, turnStone = TurnStone, fromAction]() mutable
+		{
+			solver->Ponder(board, turnStone, fromAction);
+		});
 	}
-	
-	int32 move = 0;
-	std::unordered_map<int, Evaluation> total;
+}
 
-	for (auto worker : Workers)
+void ABoard::StopSearching()
+{
+	for (const auto solver : GomokuSolvers)
 	{
-		std::unordered_map<int, Evaluation> edges = worker->Result;
-
-		if(edges.size() == 0)
-		{
-			int32 a = 0;
-		}
-		
-		for (auto& edge : edges)
-		{
-			if(total.find(edge.first) == total.end())
-			{
-				total.emplace(edge.first, edge.second);
-			}
-			else
-			{
-				total[edge.first].NumVisited += edge.second.NumVisited;
-				total[edge.first].SumScore += edge.second.SumScore;
-			}
-		}
+		solver->Stop();
 	}
+	SearchThreads->Wait();
+}
 
-	std::vector<std::pair<int, Evaluation>> sumEdgeVector;
-	for (auto edge : total)
+bool ABoard::TryGetSolution(int32& outMove)
+{
+	outMove = -1;
+	if(!IsSolving || !SearchThreads->IsIdle())
 	{
-		sumEdgeVector.push_back(std::make_pair(edge.first, edge.second));
+		return false;
 	}
+	IsSolving = false;
+
+	// the move with the most root visits summed over all solvers, among the cells some solver evaluated
+	const int32 numCells = Board.size();
+	int32 mostVisited = -1;
 	
-	std::sort(sumEdgeVector.begin(), sumEdgeVector.end(),  [](const std::pair<int, Evaluation> & a, const std::pair<int, Evaluation> & b) -> bool
-	{ 
-		return a.second.NumVisited > b.second.NumVisited; 
-	});
-	
-	if(sumEdgeVector.size() > 0)
+	for (int32 cell = 0; cell < numCells; ++cell)
 	{
-		move = sumEdgeVector[0].first;
-	}
+		bool isEvaluated = false;
+		int32 numVisited = 0;
+		for (int32 i = 0; i < (int32)GomokuSolvers.size(); ++i)
+		{
+			const int32 solverVisits = SolverEvaluations[i * numCells + cell].NumVisited;
+			isEvaluated |= solverVisits >= 0;
+			numVisited += FMath::Max(solverVisits, 0);
+		}
 
-	for (const auto worker : Workers)
-	{
-		delete worker;
+		if(isEvaluated && Board[cell] == EStoneType::Empty && numVisited > mostVisited)
+		{
+			outMove = cell;
+			mostVisited = numVisited;
+		}
 	}
-	Workers.clear();
 
-	return move;
+	return true;
 }
 
 bool ABoard::IsWinningMove(int32 move, EStoneType stoneType) const
 {
-	return BoardState::FindSequence(Board, move, stoneType, 5);
+	return BoardState::FindSequence(BitBoard(Board), move, stoneType, 5);
 }
 
 void ABoard::OnMouseClicked(float viewPortX, float viewPortY)
@@ -236,6 +279,8 @@ void ABoard::OnMouseClicked(float viewPortX, float viewPortY)
 			{
 				if(NumFullSpaces < Board.size())
 				{
+					// the pondering searches end here, Run continues from the subtree of this move
+					StopSearching();
 					Solve(GomokuSolvers.size() == 0 ? -1 : index);
 				}
 			}
@@ -248,6 +293,16 @@ void ABoard::OnMouseClicked(float viewPortX, float viewPortY)
 	}
 }
 
+int32 ABoard::GetNumSolvers() const
+{
+	return NumSolvers > 0 ? NumSolvers : ThreadPool::GetDefaultNumThreads();
+}
+
+int32 ABoard::GetSolverMemoryMB() const
+{
+	return FMath::Max(SearchMemoryMB / GetNumSolvers(), 1);
+}
+
 int32 ABoard::ClickPositionToIndex(const float x, const float y) const
 {
 	const int32 xx = x / (SpriteSize + SpriteMargin);
@@ -2,18 +2,16 @@
 
 #pragma once
 
-#include <future>
-
 #include "CoreMinimal.h"
-#include "BoardState.h"
+#include "GomokuCore/BoardState.h"
 #include "PaperSpriteActor.h"
 #include <unordered_map>
 
-#include "Solver.h"
+#include "GomokuCore/Solver.h"
 #include "Board.generated.h"
 
-class Worker;
 class Solver;
+class ThreadPool;
 class AMyPlayerController;
 
 
@@ -30,6 +28,8 @@ public:
 
 	virtual void Tick(float DeltaSeconds) override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	void Initialize(int32 DifficultyLevel, bool PlayFirstMove);
 	
 public:
@@ -49,6 +49,27 @@ public:
 	UPROPERTY(EditDefaultsOnly)
 	int32 SpriteMargin;
 
+	// independent solvers whose root visits are summed, 0 for one per hardware thread
+	UPROPERTY(EditDefaultsOnly)
+	int32 NumSolvers;
+
+	// threads searching the tree of each solver
+	UPROPERTY(EditDefaultsOnly)
+	int32 NumThreadsPerSolver;
+
+	// keep searching while the player thinks
+	UPROPERTY(EditDefaultsOnly)
+	bool Ponder;
+
+	// memory all solvers together may use for their trees, split evenly between them.
+	// A solver stops growing its tree when its part is full
+	UPROPERTY(EditDefaultsOnly)
+	int32 SearchMemoryMB;
+
+	// rotations and reflections of a position share statistics in the solvers
+	UPROPERTY(EditDefaultsOnly)
+	bool SymmetricTranspositions;
+
 public:
 	
 	int32 TimeToSolve;
@@ -70,10 +91,20 @@ private:
 
 	void Solve(int32 fromAction);
 
-	int32 TryGetSolution();
+	void StartPondering(int32 fromAction);
+
+	void StopSearching();
+
+	// true once the last Solve finished, outMove is -1 when the solvers found no move
+	bool TryGetSolution(int32& outMove);
 
 	bool IsWinningMove(int32 move, EStoneType stoneType) const;
 
+	int32 GetNumSolvers() const;
+
+	// the part of SearchMemoryMB each solver gets
+	int32 GetSolverMemoryMB() const;
+
 	static constexpr int32 Difficulties[] = {20, 75, 300, 500, 650, 800, 1000, 1500, 2000, 3500, 5000};
 	
 private:
@@ -98,12 +129,13 @@ private:
 	float CameraWidth;
 
 	std::vector<Solver*> GomokuSolvers;
-	
-	std::vector<Worker*> Workers;
-	
-	// std::vector<Solver*> GomokuSolvers;
-	
-	std::vector<std::shared_future<std::unordered_map<int, Evaluation>>> Solutions;
+
+	ThreadPool* SearchThreads;
+
+	// root edge evaluations of every solver, one board sized block per solver
+	std::vector<Evaluation> SolverEvaluations;
+
+	bool IsSolving;
 	
 	int32 NumFullSpaces;
 	
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "GomokuTypes.h"
+
+/*
+ *  Arrays aligned to more than new guarantees before C++17, e.g. to a cache line.
+ *  The block is allocated with room to spare, the array starts at the first aligned address in it
+ *  and the address of the block is kept in front of the array for Free.
+ */
+class AlignedMemory
+{
+
+public:
+
+	template<typename ElementType>
+	static ElementType* Allocate(size_t num)
+	{
+		static_assert(std::is_trivially_destructible<ElementType>::value, "aligned arrays are freed without running destructors");
+
+		const size_t alignment = alignof(ElementType) > alignof(void*) ? alignof(ElementType) : alignof(void*);
+		void* block = std::malloc(num * sizeof(ElementType) + alignment - 1 + sizeof(void*));
+		if(block == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		const uintptr_t start = (reinterpret_cast<uintptr_t>(block) + sizeof(void*) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		reinterpret_cast<void**>(start)[-1] = block;
+
+		ElementType* elements = reinterpret_cast<ElementType*>(start);
+		for (size_t i = 0; i < num; ++i)
+		{
+			new (elements + i) ElementType();
+		}
+		return elements;
+	}
+
+	static void Free(void* memory)
+	{
+		if(memory != nullptr)
+		{
+			std::free(static_cast<void**>(memory)[-1]);
+		}
+	}
+
+public:
+
+	struct Deleter
+	{
+		void operator()(void* memory) const { Free(memory); }
+	};
+
+	template<typename ElementType>
+	using Array = std::unique_ptr<ElementType[], Deleter>;
+
+};
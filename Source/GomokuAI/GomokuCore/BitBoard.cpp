@@ -0,0 +1,325 @@
+#include "BitBoard.h"
+#include "LinePattern.h"
+#include <mutex>
+
+bool CellMask::IsEmpty() const
+{
+	uint64 any = 0;
+	for (int32 i = 0; i < NumCellMaskWords; ++i)
+	{
+		any |= Words[i];
+	}
+	return any == 0;
+}
+
+int32 CellMask::Count() const
+{
+	int32 count = 0;
+	for (int32 i = 0; i < NumCellMaskWords; ++i)
+	{
+		count += FMath::CountBits(Words[i]);
+	}
+	return count;
+}
+
+uint32 CellMask::Extract(int32 start, int32 count) const
+{
+	if(start < 0)
+	{
+		return Extract(0, count + start) << (-start);
+	}
+
+	const int32 word = start >> 6;
+	const int32 bit = start & 63;
+
+	uint64 value = Words[word] >> bit;
+	if(bit + count > 64 && word + 1 < NumCellMaskWords)
+	{
+		value |= Words[word + 1] << (64 - bit);
+	}
+
+	return (uint32)(value & ((uint64(1) << count) - 1));
+}
+
+int32 CellMask::GetFirst() const
+{
+	for (int32 i = 0; i < NumCellMaskWords; ++i)
+	{
+		if(Words[i] != 0)
+		{
+			return i * 64 + (int32)FMath::CountTrailingZeros64(Words[i]);
+		}
+	}
+	return -1;
+}
+
+CellMask CellMask::Shifted(int32 offset) const
+{
+	CellMask result;
+
+	if(offset >= 0)
+	{
+		const int32 wordShift = offset >> 6;
+		const int32 bitShift = offset & 63;
+
+		for (int32 i = NumCellMaskWords - 1; i >= wordShift; --i)
+		{
+			uint64 value = Words[i - wordShift] << bitShift;
+			if(bitShift != 0 && i - wordShift - 1 >= 0)
+			{
+				value |= Words[i - wordShift - 1] >> (64 - bitShift);
+			}
+			result.Words[i] = value;
+		}
+	}
+	else
+	{
+		const int32 wordShift = (-offset) >> 6;
+		const int32 bitShift = (-offset) & 63;
+
+		for (int32 i = 0; i + wordShift < NumCellMaskWords; ++i)
+		{
+			uint64 value = Words[i + wordShift] >> bitShift;
+			if(bitShift != 0 && i + wordShift + 1 < NumCellMaskWords)
+			{
+				value |= Words[i + wordShift + 1] << (64 - bitShift);
+			}
+			result.Words[i] = value;
+		}
+	}
+
+	return result;
+}
+
+CellMask CellMask::AndNot(const CellMask& other) const
+{
+	CellMask result;
+	for (int32 i = 0; i < NumCellMaskWords; ++i)
+	{
+		result.Words[i] = Words[i] & ~other.Words[i];
+	}
+	return result;
+}
+
+CellMask& CellMask::operator|=(const CellMask& other)
+{
+	for (int32 i = 0; i < NumCellMaskWords; ++i)
+	{
+		Words[i] |= other.Words[i];
+	}
+	return *this;
+}
+
+CellMask& CellMask::operator&=(const CellMask& other)
+{
+	for (int32 i = 0; i < NumCellMaskWords; ++i)
+	{
+		Words[i] &= other.Words[i];
+	}
+	return *this;
+}
+
+CellMask CellMask::operator|(const CellMask& other) const
+{
+	CellMask result = *this;
+	result |= other;
+	return result;
+}
+
+CellMask CellMask::operator&(const CellMask& other) const
+{
+	CellMask result = *this;
+	result &= other;
+	return result;
+}
+
+bool CellMask::operator==(const CellMask& other) const
+{
+	uint64 difference = 0;
+	for (int32 i = 0; i < NumCellMaskWords; ++i)
+	{
+		difference |= Words[i] ^ other.Words[i];
+	}
+	return difference == 0;
+}
+
+static CellMask SpreadPattern(const CellMask& stones, const BoardGeometry& geometry)
+{
+	// the star pattern from BoardState::GenerateExpansionIndexes, applied to all stones at once
+	// by shifting the mask once per offset
+	
+	CellMask spread;
+
+	for (int32 y = -2; y <= 2; ++y)
+	{
+		for (int32 x = -2; x <= 2; ++x)
+		{
+			const bool xDivisible = x % 2 == 0;
+			const bool yDivisible = y % 2 == 0;
+
+			if((x != 0 || y != 0) && (xDivisible == yDivisible || x == 0 || y == 0))
+			{
+				spread |= (stones & geometry.ColumnMasks[x + 2]).Shifted(x + y * geometry.Width);
+			}
+		}
+	}
+
+	return spread & geometry.ValidCells;
+}
+
+MoveList MoveList::FromMask(const CellMask& mask)
+{
+	MoveList moves;
+	mask.ForEachIndex([&moves](int32 index)
+	{
+		moves.Add(index);
+	});
+	return moves;
+}
+
+const BoardGeometry& BoardGeometry::Get(int32 width)
+{
+	static BoardGeometry geometries[MaxBoardWidth + 1];
+	static std::once_flag initialized[MaxBoardWidth + 1];
+
+	std::call_once(initialized[width], [width]()
+	{
+		BoardGeometry& geometry = geometries[width];
+		geometry.Width = width;
+
+		for (int32 y = 0; y < width; ++y)
+		{
+			for (int32 x = 0; x < width; ++x)
+			{
+				const int32 index = x + y * width;
+				geometry.ValidCells.Set(index);
+
+				for (int32 dx = -2; dx <= 2; ++dx)
+				{
+					if(x + dx >= 0 && x + dx < width)
+					{
+						geometry.ColumnMasks[dx + 2].Set(index);
+					}
+				}
+			}
+		}
+
+		for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+		{
+			int32 dx;
+			int32 dy;
+			LinePatterns::GetDirection(direction, dx, dy);
+
+			for (int32 index = 0; index < width * width; ++index)
+			{
+				uint8 window = 0;
+				for (int32 position = 0; position < 8; ++position)
+				{
+					const int32 offset = position < 4 ? position - 4 : position - 3;
+					const int32 x = index % width + offset * dx;
+					const int32 y = index / width + offset * dy;
+
+					if(x >= 0 && x < width && y >= 0 && y < width)
+					{
+						window |= 1 << position;
+					}
+				}
+				geometry.LineWindows[direction][index] = window;
+			}
+		}
+
+		for (int32 index = 0; index < width * width; ++index)
+		{
+			const int32 x = index % width;
+			const int32 y = index / width;
+			const int32 last = width - 1;
+
+			// the four rotations, then the reflections on the vertical, horizontal and both diagonal axes
+			const int32 symmetricX[NumSymmetries] = {x, last - y, last - x, y, last - x, x, y, last - y};
+			const int32 symmetricY[NumSymmetries] = {y, x, last - y, last - x, y, last - y, x, last - x};
+
+			for (int32 symmetry = 0; symmetry < NumSymmetries; ++symmetry)
+			{
+				geometry.Symmetries[symmetry][index] = (int16)(symmetricX[symmetry] + symmetricY[symmetry] * width);
+			}
+		}
+
+		geometry.Neighbours.resize(width * width);
+		for (int32 index = 0; index < width * width; ++index)
+		{
+			CellMask single;
+			single.Set(index);
+			geometry.Neighbours[index] = SpreadPattern(single, geometry);
+		}
+	});
+
+	return geometries[width];
+}
+
+int32 BoardGeometry::GetInverseSymmetry(int32 symmetry)
+{
+	// only the quarter turns are not their own inverse
+	static constexpr int32 inverses[NumSymmetries] = {0, 3, 2, 1, 4, 5, 6, 7};
+	return inverses[symmetry];
+}
+
+BitBoard::BitBoard()
+{
+	Width = 0;
+}
+
+BitBoard::BitBoard(int32 width)
+{
+	Width = width;
+}
+
+BitBoard::BitBoard(const std::vector<EStoneType>& board)
+{
+	Width = FMath::Sqrt(board.size());
+
+	for (int32 i = 0; i < (int32)board.size(); ++i)
+	{
+		if(board[i] != EStoneType::Empty)
+		{
+			Set(i, board[i]);
+		}
+	}
+}
+
+void BitBoard::Set(int32 index, EStoneType stoneType)
+{
+	Stones[0].Clear(index);
+	Stones[1].Clear(index);
+
+	if(stoneType != EStoneType::Empty)
+	{
+		Stones[(int32)stoneType - 1].Set(index);
+	}
+}
+
+CellMask BitBoard::GetNeighbourhood() const
+{
+	const CellMask occupied = GetOccupied();
+	return SpreadPattern(occupied, BoardGeometry::Get(Width)).AndNot(occupied);
+}
+
+BitBoard BitBoard::Transformed(int32 symmetry) const
+{
+	const int16* cells = BoardGeometry::Get(Width).Symmetries[symmetry];
+	BitBoard result(Width);
+
+	for (int32 stone = 0; stone < 2; ++stone)
+	{
+		Stones[stone].ForEachIndex([&result, cells, stone](int32 index)
+		{
+			result.Stones[stone].Set(cells[index]);
+		});
+	}
+
+	return result;
+}
+
+bool BitBoard::operator==(const BitBoard& other) const
+{
+	return Width == other.Width && Stones[0] == other.Stones[0] && Stones[1] == other.Stones[1];
+}
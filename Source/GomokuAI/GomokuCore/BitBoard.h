@@ -0,0 +1,173 @@
+#pragma once
+
+#include <vector>
+#include "StoneType.h"
+
+/*
+ *  Fixed-size board representation, one bit per cell and colour.
+ *  Cells are stored row by row (index = x + y * width) so the flat index
+ *  used everywhere else in the solver maps directly to a bit position.
+ *  Boards up to 20x20 fit. Every board uses NumCellMaskWords (7) words per colour,
+ *  a 15x15 board only has bits in the first 4 of them.
+ */
+
+static constexpr int32 MaxBoardWidth = 20;
+
+static constexpr int32 MaxBoardCells = MaxBoardWidth * MaxBoardWidth;
+
+static constexpr int32 NumCellMaskWords = (MaxBoardCells + 63) / 64;
+
+// rotations and reflections of the square board, 0 is the identity
+static constexpr int32 NumSymmetries = 8;
+
+struct CellMask
+{
+	uint64 Words[NumCellMaskWords] = {};
+
+public:
+
+	bool Test(int32 index) const { return (Words[index >> 6] >> (index & 63)) & 1; }
+
+	void Set(int32 index) { Words[index >> 6] |= uint64(1) << (index & 63); }
+
+	void Clear(int32 index) { Words[index >> 6] &= ~(uint64(1) << (index & 63)); }
+
+	bool IsEmpty() const;
+
+	int32 Count() const;
+
+	// lowest set index, -1 when empty
+	int32 GetFirst() const;
+
+	// up to 32 consecutive bits starting at start, bits before the first cell read as zero
+	uint32 Extract(int32 start, int32 count) const;
+
+	CellMask Shifted(int32 offset) const;
+
+	CellMask AndNot(const CellMask& other) const;
+
+	CellMask& operator|=(const CellMask& other);
+
+	CellMask& operator&=(const CellMask& other);
+
+	CellMask operator|(const CellMask& other) const;
+
+	CellMask operator&(const CellMask& other) const;
+
+	bool operator==(const CellMask& other) const;
+
+	template<typename FunctionType>
+	void ForEachIndex(FunctionType function) const
+	{
+		for (int32 i = 0; i < NumCellMaskWords; ++i)
+		{
+			uint64 word = Words[i];
+			while(word != 0)
+			{
+				function(i * 64 + (int32)FMath::CountTrailingZeros64(word));
+				word &= word - 1;
+			}
+		}
+	}
+};
+
+/*
+ *  Per width masks used by the shift based operations, computed once per width.
+ */
+struct BoardGeometry
+{
+	int32 Width;
+
+	CellMask ValidCells;
+
+	// cells which stay on the board when moved by dx, indexed by dx + 2
+	CellMask ColumnMasks[5];
+
+	// expansion pattern around each cell, see BoardState::GenerateExpansionIndexes
+	std::vector<CellMask> Neighbours;
+
+	// which cells of the LinePatterns window around each cell are on the board, per direction
+	uint8 LineWindows[4][MaxBoardCells];
+
+	// where each cell goes under each symmetry
+	int16 Symmetries[NumSymmetries][MaxBoardCells];
+
+public:
+
+	static const BoardGeometry& Get(int32 width);
+
+	// the symmetry which maps the cells of symmetry back
+	static int32 GetInverseSymmetry(int32 symmetry);
+};
+
+/*
+ *  Fixed capacity list of cell indexes which can live on the stack.
+ */
+struct MoveList
+{
+	int16 Moves[MaxBoardCells];
+
+	int32 Num = 0;
+
+public:
+
+	void Add(int32 index) { Moves[Num++] = (int16)index; }
+
+	// removes the move at position by moving the last move into its place
+	void RemoveAtSwap(int32 position) { Moves[position] = Moves[--Num]; }
+
+	static MoveList FromMask(const CellMask& mask);
+};
+
+class BitBoard
+{
+
+public:
+
+	BitBoard();
+
+	explicit BitBoard(int32 width);
+
+	explicit BitBoard(const std::vector<EStoneType>& board);
+
+public:
+
+	EStoneType Get(int32 index) const
+	{
+		const int32 word = index >> 6;
+		const int32 bit = index & 63;
+		return (EStoneType)(((Stones[0].Words[word] >> bit) & 1) | (((Stones[1].Words[word] >> bit) & 1) << 1));
+	}
+
+	void Set(int32 index, EStoneType stoneType);
+
+	bool IsEmpty(int32 index) const { return !Stones[0].Test(index) && !Stones[1].Test(index); }
+
+	bool Has(int32 index, EStoneType stoneType) const { return Stones[(int32)stoneType - 1].Test(index); }
+
+	int32 GetWidth() const { return Width; }
+
+	int32 GetNumCells() const { return Width * Width; }
+
+	static int32 FlattenIndex(int32 x, int32 y, int32 width) { return x + y * width; }
+
+	const CellMask& GetStones(EStoneType stoneType) const { return Stones[(int32)stoneType - 1]; }
+
+	CellMask GetOccupied() const { return Stones[0] | Stones[1]; }
+
+	CellMask GetNeighbourhood() const;
+
+	// the board with every stone moved by symmetry, see BoardGeometry::Symmetries
+	BitBoard Transformed(int32 symmetry) const;
+
+	bool operator==(const BitBoard& other) const;
+
+	bool operator!=(const BitBoard& other) const { return !(*this == other); }
+
+private:
+
+	CellMask Stones[2];
+
+	int32 Width;
+
+};
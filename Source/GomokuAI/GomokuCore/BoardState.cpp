@@ -0,0 +1,504 @@
+﻿#include "BoardState.h"
+#include <algorithm>
+#include "LinePattern.h"
+#include "Rollout.h"
+#include "Solver.h"
+#include "Zobrist.h"
+
+constexpr float BoardState::Heuristics[5][3];
+
+BoardState::BoardState(const BitBoard& board, EStoneType stoneTurn)
+{
+	Board = board;
+	Turn = stoneTurn;
+	BoardWidth = board.GetWidth();
+	IsLeafState = false;
+	HasAllChildren = false;
+	LeafScore = -1;
+	DecisiveMoveIndex = -1;
+	ExpansionState = EExpansionState::NotExpanded;
+	Proof = EProofState::Unknown;
+	Edges = nullptr;
+	NumEdges = 0;
+	EdgeCapacity = 0;
+	NumVisited = 0;
+	SumScore = 0;
+	Epoch = 0;
+	Generation = 0;
+	Candidates = board.GetNeighbourhood();
+	Heuristic = Evaluate(MinScoredLength, MaxScoredLength);
+	CalculateHash();
+}
+
+BoardState::BoardState(BoardState* parent, int32 action)
+{
+	Board = parent->Board;
+	Turn = Solver::ChangeTurn(parent->Turn);
+	BoardWidth = parent->BoardWidth;
+	IsLeafState = false;
+	HasAllChildren = false;
+	LeafScore = -1;
+	DecisiveMoveIndex = -1;
+	ExpansionState = EExpansionState::NotExpanded;
+	Proof = EProofState::Unknown;
+	Edges = nullptr;
+	NumEdges = 0;
+	EdgeCapacity = 0;
+	NumVisited = 0;
+	SumScore = 0;
+	Epoch = 0;
+	Generation = 0;
+	Candidates = parent->Candidates;
+	Heuristic = parent->EvaluateMove(action, parent->Turn, MinScoredLength, MaxScoredLength) - parent->Heuristic;
+	Hash = parent->Hash ^ Zobrist::GetTurnKey();
+	PlaceAt(action, parent->Turn);
+}
+
+bool BoardState::IsExpanded() const
+{
+	return ExpansionState.load(std::memory_order_acquire) == EExpansionState::Expanded && NumEdges > 0;
+}
+
+BoardStateEdge* BoardState::FindEdge(int32 action)
+{
+	for (int32 i = 0; i < NumEdges; ++i)
+	{
+		if(Edges[i].Action == action)
+		{
+			return &Edges[i];
+		}
+	}
+	return nullptr;
+}
+
+bool BoardState::IsLeaf() const
+{
+	return ExpansionState.load(std::memory_order_acquire) == EExpansionState::Expanded && IsLeafState;
+}
+
+float BoardState::Simulate(RandomGenerator& random) const
+{
+	const EProofState proof = Proof.load(std::memory_order_acquire);
+	if(proof != EProofState::Unknown)
+		return proof == EProofState::Win ? 1 : 0;
+	
+	if(IsLeaf())
+		return LeafScore;
+
+	Rollout rollout(Board, GenerateShuffledExpansionIndexes(random));
+	const EStoneType winner = rollout.Play(Turn);
+
+	if(winner != EStoneType::Empty)
+	{
+		return winner == Turn ? 0 : 1;
+	}
+
+	return 0.5 + Heuristic / 50;
+}
+
+bool BoardState::CanPlayAt(int32 index) const
+{
+	return Board.IsEmpty(index);
+}
+
+void BoardState::PlaceAt(int32 index, EStoneType stoneType)
+{
+	Board.Set(index, stoneType);
+	Hash ^= Zobrist::GetStoneKey(index, stoneType);
+
+	Candidates |= BoardGeometry::Get(BoardWidth).Neighbours[index];
+	Candidates = Candidates.AndNot(Board.GetOccupied());
+}
+
+void BoardState::CalculateHash()
+{
+	Hash = Zobrist::Calculate(Board, Turn);
+}
+
+uint64 BoardState::GetChildHash(int32 action) const
+{
+	return Hash ^ Zobrist::GetTurnKey() ^ Zobrist::GetStoneKey(action, Turn);
+}
+
+bool BoardState::IsWinningMove(int32 index, EStoneType stoneType, int32 matchLength) const
+{
+	return FindSequence(Board, index, stoneType, matchLength);
+}
+
+bool BoardState::FindSequence(const BitBoard& board, int32 index, EStoneType stoneType, int32 maxMatchLength, CellMask* blockingMoves)
+{
+	const BoardGeometry& geometry = BoardGeometry::Get(board.GetWidth());
+
+	// a run longer than one stone needs an own stone in the expansion pattern around index
+	if(maxMatchLength > 1 && (board.GetStones(stoneType) & geometry.Neighbours[index]).IsEmpty())
+	{
+		return false;
+	}
+
+	bool isMatch = false;
+	
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		const LinePattern pattern = LinePatterns::Get(board, geometry, index, stoneType, direction);
+
+		if(pattern.GetLength() < maxMatchLength)
+		{
+			continue;
+		}
+
+		if(!blockingMoves)
+		{
+			return true;
+		}
+		isMatch = true;
+
+		// the ends of the run only count on the sides which have stones, and only within the searched distance
+		const bool hasStonesBefore = pattern.RunBefore > 0;
+		const bool hasStonesAfter = pattern.RunAfter > 0;
+		const bool endBefore = hasStonesBefore && pattern.IsOpenBefore() && pattern.RunBefore <= maxMatchLength;
+		const bool endAfter = hasStonesAfter && pattern.IsOpenAfter() && pattern.RunAfter <= maxMatchLength;
+
+		const int32 step = LinePatterns::GetStep(direction, board.GetWidth());
+
+		if(hasStonesBefore != hasStonesAfter && endBefore != endAfter)
+		{
+			blockingMoves->Set(endBefore ? LinePatterns::GetEndBefore(pattern, index, step) : LinePatterns::GetEndAfter(pattern, index, step));
+			blockingMoves->Set(index);
+		}
+		else if(endBefore && endAfter)
+		{
+			blockingMoves->Set(LinePatterns::GetEndBefore(pattern, index, step));
+			blockingMoves->Set(LinePatterns::GetEndAfter(pattern, index, step));
+			blockingMoves->Set(index);
+		}
+	}
+
+	return isMatch;
+}
+
+bool BoardState::IsWinningFour(const BitBoard& board, int32 index, EStoneType stoneType)
+{
+	const BoardGeometry& geometry = BoardGeometry::Get(board.GetWidth());
+	int32 numFours = 0;
+	
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		const ELineShape shape = LinePatterns::Get(board, geometry, index, stoneType, direction).Shape;
+
+		if(shape == ELineShape::OpenFour || shape == ELineShape::Five)
+		{
+			return true;
+		}
+		
+		numFours += shape == ELineShape::ClosedFour ? 1 : 0;
+	}
+
+	// the two lines only meet at index, so one block can not stop both fours
+	return numFours >= 2;
+}
+
+float BoardState::ScoreRun(int32 matchLength, int32 emptySpaces, int32 minMatchLength, int32 maxMatchLength)
+{
+	if(matchLength < minMatchLength)
+	{
+		return 0;
+	}
+
+	// runs longer than the table score as its last row
+	return Heuristics[FMath::Min(FMath::Min(matchLength, maxMatchLength - 1), 5) - 1][emptySpaces];
+}
+
+float BoardState::Evaluate(int32 minMatchLength, int32 maxMatchLength) const
+{
+	float total = 0;
+
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		int32 dx;
+		int32 dy;
+		LinePatterns::GetDirection(direction, dx, dy);
+
+		for (int32 index = 0; index < Board.GetNumCells(); ++index)
+		{
+			int32 x = index % BoardWidth;
+			int32 y = index / BoardWidth;
+
+			// walk every line once, from the cell which has no predecessor in this direction
+			if(x - dx >= 0 && x - dx < BoardWidth && y - dy >= 0)
+			{
+				continue;
+			}
+
+			EStoneType stoneType = EStoneType::Empty;
+			int32 matchLength = 0;
+			int32 emptySpaces = 0;
+			bool previousEmpty = false;
+
+			for (; x >= 0 && x < BoardWidth && y < BoardWidth; x += dx, y += dy)
+			{
+				const EStoneType current = Board.Get(BitBoard::FlattenIndex(x, y, BoardWidth));
+
+				if(current != EStoneType::Empty && current == stoneType)
+				{
+					matchLength++;
+				}
+				else
+				{
+					if(stoneType != EStoneType::Empty)
+					{
+						const float score = ScoreRun(matchLength, emptySpaces + (current == EStoneType::Empty ? 1 : 0), minMatchLength, maxMatchLength);
+						total += stoneType != Turn ? score : -score;
+					}
+
+					stoneType = current;
+					matchLength = 1;
+					emptySpaces = previousEmpty ? 1 : 0;
+				}
+
+				previousEmpty = current == EStoneType::Empty;
+			}
+
+			if(stoneType != EStoneType::Empty)
+			{
+				const float score = ScoreRun(matchLength, emptySpaces, minMatchLength, maxMatchLength);
+				total += stoneType != Turn ? score : -score;
+			}
+		}
+	}
+
+	return total;
+}
+
+float BoardState::EvaluateMove(int32 index, EStoneType stoneType, int32 minMatchLength, int32 maxMatchLength) const
+{
+	const EStoneType opponent = Solver::ChangeTurn(stoneType);
+	const int32 x = index % BoardWidth;
+	const int32 y = index / BoardWidth;
+
+	// only runs touching the placed stone change, the own runs on both sides join into one
+	// and the opponent's runs ending next to it lose an open end
+	float delta = 0;
+
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		int32 dx;
+		int32 dy;
+		LinePatterns::GetDirection(direction, dx, dy);
+
+		int32 emptySpacesAfterJoin = 0;
+		int32 joinedLength = 1;
+
+		for (int32 side = -1; side <= 1; side += 2)
+		{
+			int32 ownEnd;
+			const int32 ownLength = CountRun(x, y, side * dx, side * dy, stoneType, maxMatchLength - 1, ownEnd);
+			const int32 ownEmptyEnd = ownEnd != -1 && Board.IsEmpty(ownEnd) ? 1 : 0;
+
+			joinedLength += ownLength;
+			emptySpacesAfterJoin += ownEmptyEnd;
+
+			if(ownLength > 0)
+			{
+				delta -= ScoreRun(ownLength, ownEmptyEnd + 1, minMatchLength, maxMatchLength);
+				continue;
+			}
+
+			int32 opponentEnd;
+			const int32 opponentLength = CountRun(x, y, side * dx, side * dy, opponent, maxMatchLength - 1, opponentEnd);
+			if(opponentLength > 0)
+			{
+				const int32 opponentEmptyEnd = opponentEnd != -1 && Board.IsEmpty(opponentEnd) ? 1 : 0;
+				delta -= ScoreRun(opponentLength, opponentEmptyEnd, minMatchLength, maxMatchLength);
+				delta += ScoreRun(opponentLength, opponentEmptyEnd + 1, minMatchLength, maxMatchLength);
+			}
+		}
+
+		delta += ScoreRun(joinedLength, emptySpacesAfterJoin, minMatchLength, maxMatchLength);
+	}
+
+	return delta;
+}
+
+int32 BoardState::CountRun(int32 x, int32 y, int32 dx, int32 dy, EStoneType stoneType, int32 maxLength, int32& outEnd) const
+{
+	int32 length = 0;
+	outEnd = -1;
+
+	for (int32 distance = 1; distance <= maxLength + 1; ++distance)
+	{
+		const int32 xx = x + distance * dx;
+		const int32 yy = y + distance * dy;
+
+		if(xx < 0 || xx >= BoardWidth || yy < 0 || yy >= BoardWidth)
+		{
+			break;
+		}
+
+		const int32 cell = BitBoard::FlattenIndex(xx, yy, BoardWidth);
+		if(!Board.Has(cell, stoneType))
+		{
+			outEnd = cell;
+			break;
+		}
+
+		length++;
+	}
+
+	return length;
+}
+
+void BoardState::AddChildActions(const CellMask& indexes, MoveList& outActions) const
+{
+	indexes.ForEachIndex([this, &outActions](int32 index)
+	{
+		if(CanPlayAt(index))
+		{
+			outActions.Add(index);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("==========="));
+		}
+	});
+}
+
+void BoardState::Expand(MoveList& outActions)
+{
+	const CellMask& indexesToExpand = GenerateExpansionIndexes();
+	
+	CellMask winning5Moves;
+	CellMask blockWinning5Moves;
+	CellMask winning4Moves;
+	CellMask provenWinning4Moves;
+	CellMask blockingWinning4Moves;
+	CellMask winning4NotFullMoves;
+
+	indexesToExpand.ForEachIndex([&](int32 index)
+	{
+		if(!winning5Moves.IsEmpty())
+		{
+			return;
+		}
+		
+		if(IsWinningMove(index, Turn, 5))
+		{
+			winning5Moves.Set(index);
+			return;
+		}
+
+		if(IsWinningMove(index, Solver::ChangeTurn(Turn), 5))
+		{
+			blockWinning5Moves.Set(index);
+		}
+		
+		CellMask winning4MovesForIndex;
+		
+		if(FindSequence(Board, index, Turn, 4, &winning4MovesForIndex))
+		{
+			// I guess this is wrong
+			if(!winning4MovesForIndex.IsEmpty())
+			{
+				winning4Moves.Set(index);
+			}
+
+			if(IsWinningFour(Board, index, Turn))
+			{
+				provenWinning4Moves.Set(index);
+			}
+			else
+			{
+				winning4NotFullMoves.Set(index);
+			}
+		}
+		FindSequence(Board, index, Solver::ChangeTurn(Turn), 4, &blockingWinning4Moves);
+	});
+
+	if(!winning5Moves.IsEmpty())
+	{
+		IsLeafState = true;
+		LeafScore = 0;
+		DecisiveMoveIndex = winning5Moves.GetFirst();
+		Proof = EProofState::Loss;
+		return;
+	}
+	
+	if(!blockWinning5Moves.IsEmpty())
+	{
+		if(blockWinning5Moves.Count() >= 2)
+		{
+			IsLeafState = true;
+			LeafScore = 1;
+			DecisiveMoveIndex = blockWinning5Moves.GetFirst();
+			Proof = EProofState::Win;
+		}
+		else
+		{
+			AddChildActions(blockWinning5Moves, outActions);
+			HasAllChildren = true;
+		}
+		return;
+	}
+	
+	// neither side can complete five, so an open four or a double four wins
+	if(!provenWinning4Moves.IsEmpty())
+	{
+		IsLeafState = true;
+		LeafScore = 0;
+		DecisiveMoveIndex = provenWinning4Moves.GetFirst();
+		Proof = EProofState::Loss;
+		return;
+	}
+	
+	// the other fours, e.g. one closed by a stone, only likely win, so the leaf is not proven
+	if(!winning4Moves.IsEmpty())
+	{
+		IsLeafState = true;
+		LeafScore = 0;
+		DecisiveMoveIndex = winning4Moves.GetFirst();
+		return;
+	}
+	
+	if(!blockingWinning4Moves.IsEmpty())
+	{
+		AddChildActions(blockingWinning4Moves, outActions);
+		AddChildActions(winning4NotFullMoves.AndNot(blockingWinning4Moves), outActions);
+	}
+	else
+	{
+		AddChildActions(indexesToExpand, outActions);
+		HasAllChildren = true;
+	}
+	
+	if(outActions.Num == 0)
+	{
+		IsLeafState = true;
+		LeafScore = 0.5;
+	}
+}
+
+const CellMask& BoardState::GenerateExpansionIndexes() const
+{
+	/*
+	 *  Only consider spaces which are in this pattern around the X
+	 *  That's all diagonal, vertical or horizontal spaces up to distance 2,
+	 *  Spaces which are like knights move in chess are not considered for expansion 
+	 *  
+	 *         |* * *|
+	 *         | *** |
+	 *         |**X**|
+	 *         | *** |
+	 *         |* * *|
+	 *
+	 *  Candidates is kept up to date by PlaceAt, stones are never removed so no counts are needed
+	 */
+	
+	return Candidates;
+}
+
+MoveList BoardState::GenerateShuffledExpansionIndexes(RandomGenerator& random) const
+{
+	MoveList indexes = MoveList::FromMask(Candidates);
+	random.Shuffle(indexes);
+	
+	return indexes;
+}
@@ -0,0 +1,179 @@
+﻿#pragma once
+
+#include <atomic>
+#include <vector>
+#include <unordered_set>
+#include <map>
+#include <unordered_map>
+#include "BitBoard.h"
+#include "RandomGenerator.h"
+
+class BoardState;
+
+struct BoardStateEdge
+{
+	BoardStateEdge(BoardState* state = nullptr, int32 action = -1) : State(state), Action(action), NumVisited(0), SumScore(0) {}
+
+	BoardStateEdge(const BoardStateEdge& other) : State(other.State), Action(other.Action), NumVisited(other.NumVisited.load()), SumScore(other.SumScore.load()) {}
+
+	BoardStateEdge& operator=(const BoardStateEdge& other)
+	{
+		State = other.State;
+		Action = other.Action;
+		NumVisited = other.NumVisited.load();
+		SumScore = other.SumScore.load();
+		return *this;
+	}
+
+	BoardState* State;
+	
+	int32 Action;
+
+	// updated by all search threads
+	std::atomic<int32> NumVisited;
+
+	std::atomic<float> SumScore;
+};
+
+enum class EExpansionState : uint8
+{
+	NotExpanded = 0,
+	Expanding = 1,
+	Expanded = 2
+};
+
+// game theoretic value for the player who moved into the state, the same side its SumScore is for
+enum class EProofState : uint8
+{
+	Unknown = 0,
+	Win = 1,
+	Loss = 2
+};
+
+class BoardState
+{
+	
+public:
+
+	BoardState(const BitBoard& board, EStoneType stoneTurn);
+
+	// child of parent after the parent's player plays action, derived incrementally from the parent
+	BoardState(BoardState* parent, int32 action);
+
+public:
+
+	bool IsExpanded() const;
+
+	BoardStateEdge* FindEdge(int32 action);
+	
+	EStoneType GetStoneToPlay() const { return Turn; };
+
+	bool IsLeaf() const;
+
+	bool IsProven() const { return Proof.load(std::memory_order_acquire) != EProofState::Unknown; }
+	
+	float Simulate(RandomGenerator& random) const;
+	
+	const CellMask& GenerateExpansionIndexes() const;
+	
+	MoveList GenerateShuffledExpansionIndexes(RandomGenerator& random) const;
+
+	bool CanPlayAt(int32 index) const;
+
+	bool IsWinningMove(int32 index, EStoneType stoneType, int32 matchLength) const;
+
+	static bool FindSequence(const BitBoard& board, int32 index, EStoneType stoneType, int32 matchLength, CellMask* blockingMoves = nullptr);
+
+	// whether stoneType makes an open four or fours in two lines at index, which wins unless the opponent
+	// can complete five first. A four closed on one side is not enough, it can be blocked
+	static bool IsWinningFour(const BitBoard& board, int32 index, EStoneType stoneType);
+	
+	void PlaceAt(int32 index, EStoneType stoneType);
+
+	void CalculateHash();
+
+	// hash of the child reached by action, without creating it
+	uint64 GetChildHash(int32 action) const;
+	
+	float Evaluate(int32 minMatchLength, int32 maxMatchLength) const;
+
+	// change of the Heuristic for stoneType when it plays at index, only the four lines through index are read
+	float EvaluateMove(int32 index, EStoneType stoneType, int32 minMatchLength, int32 maxMatchLength) const;
+
+	void AddChildActions(const CellMask& indexes, MoveList& outActions) const;
+	
+	// marks the state as a leaf or lists the actions of its children, the solver creates the children
+	void Expand(MoveList& outActions);
+
+	static constexpr float Heuristics[5][3] =
+	{
+		{0, 0, 0},
+		{0, 1, 4},
+		{0, 2.25f, 9},
+		{0, 4, 16},
+		{25, 25, 25},
+	};
+
+	static constexpr int32 MinScoredLength = 2;
+
+	static constexpr int32 MaxScoredLength = 6;
+
+private:
+
+	static float ScoreRun(int32 matchLength, int32 emptySpaces, int32 minMatchLength, int32 maxMatchLength);
+
+	int32 CountRun(int32 x, int32 y, int32 dx, int32 dy, EStoneType stoneType, int32 maxLength, int32& outEnd) const;
+
+public:
+	
+	float LeafScore;
+	
+	BitBoard Board;
+
+	// empty cells around the stones, see GenerateExpansionIndexes
+	CellMask Candidates;
+	
+	// the thread which moves it from NotExpanded to Expanding expands the state,
+	// the leaf fields and the edges are only read once it is Expanded
+	std::atomic<EExpansionState> ExpansionState;
+
+	// set by Expand for decisive leaves and by Solver::ProveFromChildren, never changes once proven
+	std::atomic<EProofState> Proof;
+
+	// outgoing edges in one contiguous array allocated by the solver
+	BoardStateEdge* Edges;
+
+	int32 NumEdges;
+
+	int32 EdgeCapacity;
+
+	float Heuristic;
+
+	// visits and score summed over all edges leading to this node
+	std::atomic<int32> NumVisited;
+
+	std::atomic<float> SumScore;
+	
+	EStoneType Turn;
+
+	bool IsLeafState;
+
+	// the edges are every candidate or the single block of a five. Expand leaves out the moves which
+	// do not answer a four, and one of those may hold, so only then does losing every child lose the state
+	bool HasAllChildren;
+
+	int32 DecisiveMoveIndex;
+
+	uint64 Hash;
+
+	// see Solver::CollectGarbage
+	uint32 Epoch;
+
+	// search the node was created in, see TranspositionTable::Insert
+	uint32 Generation;
+
+public:
+	
+	int32 BoardWidth;
+	
+};
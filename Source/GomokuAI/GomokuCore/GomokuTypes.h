@@ -0,0 +1,51 @@
+#pragma once
+
+/*
+ *  The only engine types the search core uses. Inside the GomokuAI module they come from
+ *  the engine, the headless library build (GOMOKU_HEADLESS, see CMakeLists.txt) defines
+ *  the same names on top of the standard library.
+ */
+
+#ifdef GOMOKU_HEADLESS
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+typedef signed char int8;
+typedef short int16;
+typedef int int32;
+typedef long long int64;
+
+typedef unsigned char uint8;
+typedef unsigned short uint16;
+typedef unsigned int uint32;
+typedef unsigned long long uint64;
+
+struct FMath
+{
+	template<typename ValueType>
+	static constexpr ValueType Min(const ValueType a, const ValueType b) { return a < b ? a : b; }
+
+	template<typename ValueType>
+	static constexpr ValueType Max(const ValueType a, const ValueType b) { return a > b ? a : b; }
+
+	static float Sqrt(float value) { return std::sqrt(value); }
+
+	static float Loge(float value) { return std::log(value); }
+
+	static uint64 CountTrailingZeros64(uint64 value) { return value == 0 ? 64 : (uint64)__builtin_ctzll(value); }
+
+	static int32 CountBits(uint64 value) { return __builtin_popcountll(value); }
+};
+
+// reflection markup and logging are engine features, the headless build has neither
+#define UENUM(...)
+
+#define UE_LOG(...) ((void)0)
+
+#else
+
+#include "CoreMinimal.h"
+
+#endif
@@ -0,0 +1,149 @@
+#include "LinePattern.h"
+
+/*
+ *  Window positions 0-3 are the cells 4 to 1 steps before the centre, 4-7 the cells 1 to 4 steps after it.
+ *  Digit of a position: 0 blocked, 1 own stone, 2 empty.
+ */
+
+static constexpr int32 WindowDigit(int32 code, int32 offset)
+{
+	int32 position = offset < 0 ? offset + 4 : offset + 3;
+	while(position-- > 0)
+	{
+		code /= 3;
+	}
+	return code % 3;
+}
+
+static constexpr LinePattern ClassifyPattern(int32 code)
+{
+	LinePattern pattern = {0, 0, 0, ELineShape::None};
+
+	while(pattern.RunBefore < 4 && WindowDigit(code, -(pattern.RunBefore + 1)) == 1)
+	{
+		pattern.RunBefore++;
+	}
+	while(pattern.RunAfter < 4 && WindowDigit(code, pattern.RunAfter + 1) == 1)
+	{
+		pattern.RunAfter++;
+	}
+
+	const bool openBefore = pattern.RunBefore < 4 && WindowDigit(code, -(pattern.RunBefore + 1)) == 2;
+	const bool openAfter = pattern.RunAfter < 4 && WindowDigit(code, pattern.RunAfter + 1) == 2;
+	pattern.OpenEnds = (openBefore ? 1 : 0) | (openAfter ? 2 : 0);
+
+	const int32 length = 1 + pattern.RunBefore + pattern.RunAfter;
+	const int32 numOpenEnds = (openBefore ? 1 : 0) + (openAfter ? 1 : 0);
+
+	if(length >= 5)
+	{
+		pattern.Shape = ELineShape::Five;
+	}
+	else if(length == 4 && numOpenEnds == 2)
+	{
+		pattern.Shape = ELineShape::OpenFour;
+	}
+	else if(length == 4 && numOpenEnds == 1)
+	{
+		pattern.Shape = ELineShape::ClosedFour;
+	}
+	else if(length == 3 && numOpenEnds == 2)
+	{
+		// an open three needs room to become an open four on at least one side
+		const bool roomBefore = WindowDigit(code, -(pattern.RunBefore + 2)) == 2;
+		const bool roomAfter = WindowDigit(code, pattern.RunAfter + 2) == 2;
+
+		if(roomBefore || roomAfter)
+		{
+			pattern.Shape = ELineShape::OpenThree;
+		}
+	}
+
+	return pattern;
+}
+
+static constexpr LinePatterns::PatternTable GeneratePatternTable()
+{
+	LinePatterns::PatternTable table = {};
+
+	for (int32 code = 0; code < LinePatterns::NumPatterns; ++code)
+	{
+		table.Patterns[code] = ClassifyPattern(code);
+	}
+
+	for (int32 bits = 0; bits < 256; ++bits)
+	{
+		int32 ternary = 0;
+		int32 power = 1;
+		for (int32 position = 0; position < 8; ++position)
+		{
+			if(bits & (1 << position))
+			{
+				ternary += power;
+			}
+			power *= 3;
+		}
+		table.Ternary[bits] = ternary;
+	}
+
+	return table;
+}
+
+const LinePatterns::PatternTable LinePatterns::Table = GeneratePatternTable();
+
+// horizontal, vertical, decreasing and increasing diagonal
+static constexpr int32 LineDirections[LinePatterns::NumDirections][2] = {{1, 0}, {0, 1}, {-1, 1}, {1, 1}};
+
+void LinePatterns::GetDirection(int32 direction, int32& outDx, int32& outDy)
+{
+	outDx = LineDirections[direction][0];
+	outDy = LineDirections[direction][1];
+}
+
+int32 LinePatterns::GetStep(int32 direction, int32 boardWidth)
+{
+	return LineDirections[direction][0] + LineDirections[direction][1] * boardWidth;
+}
+
+LinePattern LinePatterns::Get(const BitBoard& board, int32 index, EStoneType stoneType, int32 direction)
+{
+	return Get(board, BoardGeometry::Get(board.GetWidth()), index, stoneType, direction);
+}
+
+LinePattern LinePatterns::Get(const BitBoard& board, const BoardGeometry& geometry, int32 index, EStoneType stoneType, int32 direction)
+{
+	const CellMask& own = board.GetStones(stoneType);
+	const CellMask& other = board.GetStones(stoneType == EStoneType::X ? EStoneType::O : EStoneType::X);
+
+	uint32 ownBits = 0;
+	uint32 otherBits = 0;
+
+	if(direction == 0)
+	{
+		// rows are contiguous in the bit-planes, so the whole window is one shift and mask
+		const uint32 ownWindow = own.Extract(index - WindowRadius, 2 * WindowRadius + 1);
+		const uint32 otherWindow = other.Extract(index - WindowRadius, 2 * WindowRadius + 1);
+		ownBits = (ownWindow & 0xFu) | ((ownWindow >> 5) << 4);
+		otherBits = (otherWindow & 0xFu) | ((otherWindow >> 5) << 4);
+	}
+	else
+	{
+		const int32 step = GetStep(direction, board.GetWidth());
+
+		for (int32 position = 0; position < 8; ++position)
+		{
+			// cells outside the board are clamped to a valid bit and masked out below
+			int32 cell = index + (position < 4 ? position - 4 : position - 3) * step;
+			cell = cell < 0 ? 0 : (cell >= MaxBoardCells ? MaxBoardCells - 1 : cell);
+
+			ownBits |= (uint32)own.Test(cell) << position;
+			otherBits |= (uint32)other.Test(cell) << position;
+		}
+	}
+
+	const uint32 onBoard = geometry.LineWindows[direction][index];
+	ownBits &= onBoard;
+	const uint32 emptyBits = ~(ownBits | otherBits) & onBoard;
+
+	return Table.Patterns[Table.Ternary[ownBits] + 2 * Table.Ternary[emptyBits]];
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "BitBoard.h"
+
+/*
+ *  Classification of the line through a cell, assuming a stone of the given colour is placed there.
+ *  The 4 cells on either side of the centre are encoded as a base 3 number
+ *  (blocked or outside the board, own stone, empty) and looked up in a table generated at compile time.
+ */
+
+enum class ELineShape : uint8
+{
+	None = 0,
+	OpenThree = 1,
+	ClosedFour = 2,
+	OpenFour = 3,
+	Five = 4
+};
+
+struct LinePattern
+{
+	// own stones directly before and after the centre
+	uint8 RunBefore;
+
+	uint8 RunAfter;
+
+	// bit 0 set when the cell ending the run before the centre is empty, bit 1 the same after the centre
+	uint8 OpenEnds;
+
+	ELineShape Shape;
+
+public:
+
+	int32 GetLength() const { return 1 + RunBefore + RunAfter; }
+
+	bool IsOpenBefore() const { return OpenEnds & 1; }
+
+	bool IsOpenAfter() const { return OpenEnds & 2; }
+};
+
+class LinePatterns
+{
+
+public:
+
+	static constexpr int32 NumDirections = 4;
+
+	static constexpr int32 WindowRadius = 4;
+
+	static constexpr int32 NumPatterns = 6561;
+
+	static LinePattern Get(const BitBoard& board, int32 index, EStoneType stoneType, int32 direction);
+
+	// same as above with the geometry of the board already looked up, for callers reading several lines
+	static LinePattern Get(const BitBoard& board, const BoardGeometry& geometry, int32 index, EStoneType stoneType, int32 direction);
+
+	static void GetDirection(int32 direction, int32& outDx, int32& outDy);
+
+	// offset between neighbouring cells of the line in the given direction
+	static int32 GetStep(int32 direction, int32 boardWidth);
+
+	static int32 GetEndBefore(const LinePattern& pattern, int32 index, int32 step) { return index - (pattern.RunBefore + 1) * step; }
+
+	static int32 GetEndAfter(const LinePattern& pattern, int32 index, int32 step) { return index + (pattern.RunAfter + 1) * step; }
+
+public:
+
+	struct PatternTable
+	{
+		LinePattern Patterns[NumPatterns];
+
+		uint16 Ternary[256];
+	};
+
+private:
+
+	static const PatternTable Table;
+
+};
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "AlignedMemory.h"
+#include "GomokuTypes.h"
+
+/*
+ *  Slab allocator for search nodes. Nodes are bump allocated from slabs of fixed size,
+ *  freed nodes go to a free list and are reused first. Reset forgets every node at once
+ *  and keeps the slabs, so a new search does not go back to the system allocator.
+ */
+template<typename NodeType, int32 SlabSize = 4096>
+class NodeArena
+{
+
+public:
+
+	NodeArena() : FreeList(nullptr), CurrentSlab(0), NumUsedInSlab(0), NumAllocated(0) {}
+
+	NodeArena(const NodeArena&) = delete;
+
+	NodeArena& operator=(const NodeArena&) = delete;
+
+public:
+
+	template<typename... ArgTypes>
+	NodeType* Allocate(ArgTypes&&... args)
+	{
+		return new (AllocateSlot()) NodeType(std::forward<ArgTypes>(args)...);
+	}
+
+	void Free(NodeType* node)
+	{
+		node->~NodeType();
+
+		FreeSlot* slot = reinterpret_cast<FreeSlot*>(node);
+		slot->Next = FreeList;
+		FreeList = slot;
+		NumAllocated--;
+	}
+
+	// destructors of the nodes still allocated are not run
+	void Reset()
+	{
+		FreeList = nullptr;
+		CurrentSlab = 0;
+		NumUsedInSlab = 0;
+		NumAllocated = 0;
+	}
+
+	int32 GetNumAllocated() const { return NumAllocated; }
+
+	size_t GetReservedBytes() const { return Slabs.size() * SlabSize * sizeof(Slot); }
+
+private:
+
+	void* AllocateSlot()
+	{
+		NumAllocated++;
+
+		if(FreeList != nullptr)
+		{
+			FreeSlot* slot = FreeList;
+			FreeList = slot->Next;
+			return slot;
+		}
+
+		if(NumUsedInSlab == SlabSize)
+		{
+			CurrentSlab++;
+			NumUsedInSlab = 0;
+		}
+		if(CurrentSlab == (int32)Slabs.size())
+		{
+			Slabs.emplace_back(new Slot[SlabSize]);
+		}
+
+		return &Slabs[CurrentSlab][NumUsedInSlab++];
+	}
+
+private:
+
+	struct FreeSlot
+	{
+		FreeSlot* Next;
+	};
+
+	using Slot = typename std::aligned_storage<(sizeof(NodeType) > sizeof(FreeSlot) ? sizeof(NodeType) : sizeof(FreeSlot)), alignof(NodeType)>::type;
+
+	std::vector<std::unique_ptr<Slot[]>> Slabs;
+
+	FreeSlot* FreeList;
+
+	int32 CurrentSlab;
+
+	int32 NumUsedInSlab;
+
+	int32 NumAllocated;
+
+};
+
+/*
+ *  Allocator for the variable length arrays of a node, e.g. its edges. Arrays start on a cache line
+ *  and take whole cache lines, freed arrays are kept in one free list per number of lines.
+ */
+template<typename ElementType, int32 SlabLines = 4096>
+class ArrayArena
+{
+	static_assert(std::is_trivially_destructible<ElementType>::value, "array elements are never destroyed");
+
+public:
+
+	ArrayArena() : CurrentSlab(0), NumUsedInSlab(0) {}
+
+	ArrayArena(const ArrayArena&) = delete;
+
+	ArrayArena& operator=(const ArrayArena&) = delete;
+
+public:
+
+	ElementType* Allocate(int32 num)
+	{
+		ElementType* elements = reinterpret_cast<ElementType*>(AllocateLines(GetNumLines(num)));
+		for (int32 i = 0; i < num; ++i)
+		{
+			new (elements + i) ElementType();
+		}
+		return elements;
+	}
+
+	// num has to be the number the array was allocated with
+	void Free(ElementType* elements, int32 num)
+	{
+		const int32 numLines = GetNumLines(num);
+		if(numLines >= (int32)FreeLists.size())
+		{
+			FreeLists.resize(numLines + 1, nullptr);
+		}
+
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(elements);
+		block->Next = FreeLists[numLines];
+		FreeLists[numLines] = block;
+	}
+
+	void Reset()
+	{
+		std::fill(FreeLists.begin(), FreeLists.end(), nullptr);
+		CurrentSlab = 0;
+		NumUsedInSlab = 0;
+	}
+
+	size_t GetReservedBytes() const
+	{
+		size_t numLines = 0;
+		for (const auto& slab : Slabs)
+		{
+			numLines += slab.second;
+		}
+		return numLines * sizeof(CacheLine);
+	}
+
+private:
+
+	struct alignas(64) CacheLine
+	{
+		uint8 Bytes[64];
+	};
+
+	struct FreeBlock
+	{
+		FreeBlock* Next;
+	};
+
+	static int32 GetNumLines(int32 num)
+	{
+		const int32 numLines = (int32)((num * sizeof(ElementType) + sizeof(CacheLine) - 1) / sizeof(CacheLine));
+		return numLines > 0 ? numLines : 1;
+	}
+
+	void* AllocateLines(int32 numLines)
+	{
+		if(numLines < (int32)FreeLists.size() && FreeLists[numLines] != nullptr)
+		{
+			FreeBlock* block = FreeLists[numLines];
+			FreeLists[numLines] = block->Next;
+			return block;
+		}
+
+		// arrays never span two slabs, the rest of a slab which is too small is skipped
+		while(CurrentSlab < (int32)Slabs.size() && NumUsedInSlab + numLines > Slabs[CurrentSlab].second)
+		{
+			CurrentSlab++;
+			NumUsedInSlab = 0;
+		}
+		if(CurrentSlab == (int32)Slabs.size())
+		{
+			const int32 slabLines = numLines > SlabLines ? numLines : SlabLines;
+			Slabs.emplace_back(AlignedMemory::Array<CacheLine>(AlignedMemory::Allocate<CacheLine>(slabLines)), slabLines);
+			NumUsedInSlab = 0;
+		}
+
+		CacheLine* lines = Slabs[CurrentSlab].first.get() + NumUsedInSlab;
+		NumUsedInSlab += numLines;
+		return lines;
+	}
+
+private:
+
+	std::vector<std::pair<AlignedMemory::Array<CacheLine>, int32>> Slabs;
+
+	std::vector<FreeBlock*> FreeLists;
+
+	int32 CurrentSlab;
+
+	int32 NumUsedInSlab;
+
+};
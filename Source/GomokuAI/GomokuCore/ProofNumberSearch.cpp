@@ -0,0 +1,265 @@
+#include "ProofNumberSearch.h"
+#include <vector>
+#include "ThreatMoves.h"
+#include "Zobrist.h"
+
+ProofNumberSearch::ProofNumberSearch() : NumBuckets(0)
+{
+	Geometry = nullptr;
+	Turn = EStoneType::X;
+	Attacker = EStoneType::X;
+	RootNumbers = ProofNumbers{1, 1};
+	BestMove = -1;
+	MaxNodes = 0;
+	MaxTime = 0;
+	NumNodes = 0;
+	IsAborted = false;
+	Resize(sizeof(Bucket));
+}
+
+ProofNumberSearch::ProofNumberSearch(int32 memoryMegabytes) : ProofNumberSearch()
+{
+	Resize((size_t)FMath::Max(memoryMegabytes, 1) << 20);
+}
+
+void ProofNumberSearch::Resize(size_t sizeInBytes)
+{
+	uint64 numBuckets = 1;
+	while(numBuckets * 2 * sizeof(Bucket) <= sizeInBytes)
+	{
+		numBuckets *= 2;
+	}
+
+	if(numBuckets != NumBuckets)
+	{
+		Buckets.reset(new Bucket[numBuckets]);
+		NumBuckets = numBuckets;
+	}
+	Clear();
+}
+
+void ProofNumberSearch::Clear()
+{
+	for (uint64 i = 0; i < NumBuckets; ++i)
+	{
+		for (Entry& entry : Buckets[i].Entries)
+		{
+			entry = Entry{0, ProofNumbers{1, 1}, 0};
+		}
+	}
+}
+
+EProofResult ProofNumberSearch::Solve(const BitBoard& board, EStoneType turn, int32 maxNodes, float maxTime)
+{
+	if(turn != Attacker)
+	{
+		Clear();
+	}
+
+	Board = board;
+	Geometry = &BoardGeometry::Get(board.GetWidth());
+	Turn = turn;
+	Attacker = turn;
+	BestMove = -1;
+	MaxNodes = maxNodes;
+	MaxTime = maxTime;
+	NumNodes = 0;
+	IsAborted = false;
+	Deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(maxTime));
+
+	RootNumbers = SearchNode(Zobrist::Calculate(board, turn), Infinity, Infinity, true);
+
+	if(RootNumbers.Proof == 0)
+	{
+		return EProofResult::Proven;
+	}
+	if(RootNumbers.Disproof == 0)
+	{
+		return EProofResult::Disproven;
+	}
+	return EProofResult::Unknown;
+}
+
+ProofNumberSearch::ProofNumbers ProofNumberSearch::SearchNode(uint64 key, uint32 proofThreshold, uint32 disproofThreshold, bool isRoot)
+{
+	const int32 startNumNodes = NumNodes++;
+
+	// the attacker needs one winning move, against the defender every move has to win
+	const bool isOr = Turn == Attacker;
+
+	MoveList moves;
+	ProofNumbers numbers;
+	int32 winningMove;
+
+	if(Evaluate(moves, numbers, winningMove))
+	{
+		if(isRoot && numbers.Proof == 0)
+		{
+			BestMove = winningMove;
+		}
+
+		Store(key, numbers, 1);
+		return numbers;
+	}
+
+	// the children are only played on the board while one of them is searched
+	std::vector<uint64> childKeys(moves.Num);
+	for (int32 i = 0; i < moves.Num; ++i)
+	{
+		childKeys[i] = key ^ Zobrist::GetTurnKey() ^ Zobrist::GetStoneKey(moves.Moves[i], Turn);
+	}
+
+	int32 bestChild = 0;
+
+	while(true)
+	{
+		// the number the node selects by is the minimum over the children, the other one their sum
+		uint32 minValue = Infinity;
+		uint32 secondValue = Infinity;
+		uint32 sumValue = 0;
+
+		for (int32 i = 0; i < moves.Num; ++i)
+		{
+			const ProofNumbers childNumbers = Find(childKeys[i]);
+			const uint32 selectValue = isOr ? childNumbers.Proof : childNumbers.Disproof;
+
+			sumValue = AddSaturated(sumValue, isOr ? childNumbers.Disproof : childNumbers.Proof);
+
+			if(selectValue < minValue)
+			{
+				secondValue = minValue;
+				minValue = selectValue;
+				bestChild = i;
+			}
+			else if(selectValue < secondValue)
+			{
+				secondValue = selectValue;
+			}
+		}
+
+		numbers = isOr ? ProofNumbers{minValue, sumValue} : ProofNumbers{sumValue, minValue};
+
+		if(numbers.Proof >= proofThreshold || numbers.Disproof >= disproofThreshold || IsOutOfBudget())
+		{
+			break;
+		}
+
+		// the best child is searched until it is worse than the second best or the node passes a threshold
+		const ProofNumbers bestNumbers = Find(childKeys[bestChild]);
+		uint32 childProofThreshold;
+		uint32 childDisproofThreshold;
+
+		if(isOr)
+		{
+			childProofThreshold = FMath::Min(proofThreshold, AddSaturated(secondValue, 1));
+			childDisproofThreshold = (uint32)FMath::Min<int64>((int64)disproofThreshold - numbers.Disproof + bestNumbers.Disproof, Infinity);
+		}
+		else
+		{
+			childDisproofThreshold = FMath::Min(disproofThreshold, AddSaturated(secondValue, 1));
+			childProofThreshold = (uint32)FMath::Min<int64>((int64)proofThreshold - numbers.Proof + bestNumbers.Proof, Infinity);
+		}
+
+		const int32 move = moves.Moves[bestChild];
+		const EStoneType turn = Turn;
+
+		Board.Set(move, turn);
+		Turn = GetOpponent(turn);
+		SearchNode(childKeys[bestChild], childProofThreshold, childDisproofThreshold, false);
+		Turn = turn;
+		Board.Set(move, EStoneType::Empty);
+	}
+
+	if(isRoot && numbers.Proof == 0)
+	{
+		BestMove = moves.Moves[bestChild];
+	}
+
+	Store(key, numbers, (uint32)(NumNodes - startNumNodes));
+	return numbers;
+}
+
+bool ProofNumberSearch::Evaluate(MoveList& outMoves, ProofNumbers& outNumbers, int32& outWinningMove)
+{
+	outWinningMove = -1;
+
+	if(Turn == Attacker)
+	{
+		// only a five ends the search as a win, every other threat is searched to one
+		const CellMask wins = ThreatMoves::GetFiveCells(Board, Attacker);
+		if(!wins.IsEmpty())
+		{
+			outWinningMove = wins.GetFirst();
+			outNumbers = ProofNumbers{0, Infinity};
+			return true;
+		}
+
+		outMoves = ThreatMoves::GetAttacks(Board, *Geometry, Attacker, true);
+	}
+	else if(ThreatMoves::GetFiveCells(Board, Turn).IsEmpty())
+	{
+		outMoves = MoveList::FromMask(ThreatMoves::GetDefences(Board, *Geometry, Attacker));
+	}
+
+	// a five of the defender, or no threat to play or to answer
+	if(outMoves.Num == 0)
+	{
+		outNumbers = ProofNumbers{Infinity, 0};
+		return true;
+	}
+	return false;
+}
+
+ProofNumberSearch::ProofNumbers ProofNumberSearch::Find(uint64 key) const
+{
+	for (const Entry& entry : Buckets[key & (NumBuckets - 1)].Entries)
+	{
+		if(entry.Work != 0 && entry.Key == key)
+		{
+			return entry.Numbers;
+		}
+	}
+	return ProofNumbers{1, 1};
+}
+
+void ProofNumberSearch::Store(uint64 key, ProofNumbers numbers, uint32 work)
+{
+	Bucket& bucket = Buckets[key & (NumBuckets - 1)];
+
+	for (Entry& entry : bucket.Entries)
+	{
+		if(entry.Work != 0 && entry.Key == key)
+		{
+			entry.Numbers = numbers;
+			entry.Work += work;
+			return;
+		}
+	}
+
+	Entry* victim = &bucket.Entries[0];
+	for (Entry& entry : bucket.Entries)
+	{
+		if(entry.Work < victim->Work)
+		{
+			victim = &entry;
+		}
+	}
+
+	*victim = Entry{key, numbers, work};
+}
+
+bool ProofNumberSearch::IsOutOfBudget()
+{
+	if(MaxNodes > 0 && NumNodes >= MaxNodes)
+	{
+		IsAborted = true;
+	}
+
+	// the clock is only read every few nodes
+	if(MaxTime > 0 && NumNodes % ClockCheckInterval == 0 && std::chrono::steady_clock::now() >= Deadline)
+	{
+		IsAborted = true;
+	}
+
+	return IsAborted;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include "BitBoard.h"
+
+enum class EProofResult : uint8
+{
+	Unknown = 0,
+	Proven = 1,
+	Disproven = 2
+};
+
+/*
+ *  Depth-first proof-number search (df-pn) over the threats of ThreatMoves. The side to move plays
+ *  its fours and threes and the other side every reply which does not lose at once, so a proof is
+ *  a forced win which only ends in a five. Disproven means there is no win by threats.
+ *  The proof and disproof numbers of every searched position are kept in a fixed size
+ *  transposition table, so the memory does not grow with the search and a later call on
+ *  a nearby position starts from what the earlier ones learned.
+ */
+class ProofNumberSearch
+{
+
+public:
+
+	ProofNumberSearch();
+
+	explicit ProofNumberSearch(int32 memoryMegabytes);
+
+	ProofNumberSearch(const ProofNumberSearch&) = delete;
+
+	ProofNumberSearch& operator=(const ProofNumberSearch&) = delete;
+
+public:
+
+	// rounds down to a power of two number of buckets, forgets every entry
+	void Resize(size_t sizeInBytes);
+
+	void Clear();
+
+	size_t GetSizeInBytes() const { return NumBuckets * sizeof(Bucket); }
+
+	// a budget of 0 nodes or seconds is no limit on it, Unknown when it runs out first
+	EProofResult Solve(const BitBoard& board, EStoneType turn, int32 maxNodes, float maxTime);
+
+	// numbers of the last solved root, 0 proof means proven and 0 disproof disproven
+	uint32 GetProofNumber() const { return RootNumbers.Proof; }
+
+	uint32 GetDisproofNumber() const { return RootNumbers.Disproof; }
+
+	// winning move of a proven root, -1 otherwise
+	int32 GetBestMove() const { return BestMove; }
+
+	int32 GetNumNodes() const { return NumNodes; }
+
+	static constexpr uint32 Infinity = 1u << 30;
+
+	static constexpr int32 ClockCheckInterval = 64;
+
+private:
+
+	struct ProofNumbers
+	{
+		uint32 Proof;
+
+		uint32 Disproof;
+	};
+
+	// Board holds the position and Turn is to move, both are restored before returning
+	ProofNumbers SearchNode(uint64 key, uint32 proofThreshold, uint32 disproofThreshold, bool isRoot);
+
+	// numbers of a position which is decided without searching it, else false and the moves to search
+	bool Evaluate(MoveList& outMoves, ProofNumbers& outNumbers, int32& outWinningMove);
+
+	// unknown positions start with both numbers at 1
+	ProofNumbers Find(uint64 key) const;
+
+	// an empty entry or else the one with the least work below it is replaced
+	void Store(uint64 key, ProofNumbers numbers, uint32 work);
+
+	bool IsOutOfBudget();
+
+	static uint32 AddSaturated(uint32 a, uint32 b) { return FMath::Min(a + b, Infinity); }
+
+	static EStoneType GetOpponent(EStoneType stoneType) { return stoneType == EStoneType::X ? EStoneType::O : EStoneType::X; }
+
+private:
+
+	struct Entry
+	{
+		uint64 Key;
+
+		ProofNumbers Numbers;
+
+		// nodes searched below the position, 0 for an empty entry
+		uint32 Work;
+	};
+
+	static constexpr int32 BucketSize = 4;
+
+	struct Bucket
+	{
+		Entry Entries[BucketSize];
+	};
+
+	std::unique_ptr<Bucket[]> Buckets;
+
+	uint64 NumBuckets;
+
+	BitBoard Board;
+
+	const BoardGeometry* Geometry;
+
+	EStoneType Turn;
+
+	// the table holds numbers for this side, it is cleared when the other side is solved for
+	EStoneType Attacker;
+
+	ProofNumbers RootNumbers;
+
+	int32 BestMove;
+
+	int32 MaxNodes;
+
+	float MaxTime;
+
+	int32 NumNodes;
+
+	bool IsAborted;
+
+	std::chrono::steady_clock::time_point Deadline;
+
+};
@@ -0,0 +1,58 @@
+#include "RandomGenerator.h"
+#include <random>
+
+RandomGenerator::RandomGenerator()
+{
+	Seed(MakeSeed());
+}
+
+RandomGenerator::RandomGenerator(uint64 seed)
+{
+	Seed(seed);
+}
+
+void RandomGenerator::Seed(uint64 seed)
+{
+	// splitmix64 spreads similar seeds over the whole state and never produces the all zero state
+	for (int32 i = 0; i < 4; ++i)
+	{
+		State[i] = SplitMix64(seed);
+	}
+}
+
+static uint64 RotateLeft(uint64 value, int32 count)
+{
+	return (value << count) | (value >> (64 - count));
+}
+
+uint64 RandomGenerator::Next()
+{
+	const uint64 result = RotateLeft(State[1] * 5, 7) * 9;
+	const uint64 t = State[1] << 17;
+
+	State[2] ^= State[0];
+	State[3] ^= State[1];
+	State[1] ^= State[2];
+	State[0] ^= State[3];
+	State[2] ^= t;
+	State[3] = RotateLeft(State[3], 45);
+
+	return result;
+}
+
+void RandomGenerator::Shuffle(MoveList& moves)
+{
+	for (int32 i = moves.Num - 1; i > 0; --i)
+	{
+		const int32 j = NextInt(i + 1);
+		const int16 move = moves.Moves[i];
+		moves.Moves[i] = moves.Moves[j];
+		moves.Moves[j] = move;
+	}
+}
+
+uint64 RandomGenerator::MakeSeed()
+{
+	std::random_device device;
+	return ((uint64)device() << 32) ^ device();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "BitBoard.h"
+
+static constexpr uint64 SplitMix64(uint64& state)
+{
+	state += 0x9E3779B97F4A7C15ull;
+	uint64 value = state;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+}
+
+/*
+ *  xoshiro256** generator. Each solver owns one, so no state is shared between threads,
+ *  and a fixed seed makes a search repeat move for move.
+ */
+class RandomGenerator
+{
+
+public:
+
+	// seeded from std::random_device
+	RandomGenerator();
+
+	explicit RandomGenerator(uint64 seed);
+
+public:
+
+	void Seed(uint64 seed);
+
+	uint64 Next();
+
+	// uniform in [0, bound)
+	int32 NextInt(int32 bound) { return (int32)(((Next() >> 32) * (uint64)bound) >> 32); }
+
+	void Shuffle(MoveList& moves);
+
+	static uint64 MakeSeed();
+
+private:
+
+	uint64 State[4];
+
+};
@@ -0,0 +1,113 @@
+#include "Rollout.h"
+
+Rollout::Rollout(const BitBoard& board, const MoveList& moves) :
+	Geometry(BoardGeometry::Get(board.GetWidth())),
+	Board(board),
+	Moves(moves)
+{
+	for (int32 i = 0; i < Moves.Num; ++i)
+	{
+		const int32 index = Moves.Moves[i];
+		Remaining.Set(index);
+
+		for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+		{
+			UpdateRuns(index, direction);
+		}
+		UpdateThreats(index);
+	}
+}
+
+EStoneType Rollout::Play(EStoneType turn)
+{
+	while(Moves.Num != 0)
+	{
+		const CellMask forcing = Fives[0] | Fives[1] | Fours[0] | Fours[1];
+
+		// first forcing move in the playout order, the last move when there is none
+		int32 position = 0;
+		while(position < Moves.Num - 1 && !forcing.Test(Moves.Moves[position]))
+		{
+			position++;
+		}
+
+		const int32 move = Moves.Moves[position];
+		if(Fives[(int32)turn - 1].Test(move))
+		{
+			return turn;
+		}
+
+		Moves.RemoveAtSwap(position);
+		Place(move, turn);
+		turn = turn == EStoneType::X ? EStoneType::O : EStoneType::X;
+	}
+
+	return EStoneType::Empty;
+}
+
+void Rollout::Place(int32 index, EStoneType stoneType)
+{
+	Board.Set(index, stoneType);
+	Remaining.Clear(index);
+
+	for (int32 player = 0; player < 2; ++player)
+	{
+		Fives[player].Clear(index);
+		Fours[player].Clear(index);
+	}
+
+	// only the cells within the pattern window along the four lines through index can change
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		const int32 step = LinePatterns::GetStep(direction, Board.GetWidth());
+		const uint8 window = Geometry.LineWindows[direction][index];
+
+		for (int32 position = 0; position < 2 * LinePatterns::WindowRadius; ++position)
+		{
+			const int32 offset = position < LinePatterns::WindowRadius ? position - LinePatterns::WindowRadius : position - LinePatterns::WindowRadius + 1;
+			const int32 cell = index + offset * step;
+
+			if((window & (1 << position)) && Remaining.Test(cell))
+			{
+				UpdateRuns(cell, direction);
+				UpdateThreats(cell);
+			}
+		}
+	}
+}
+
+void Rollout::UpdateRuns(int32 index, int32 direction)
+{
+	RunLengths[0][direction][index] = (uint8)LinePatterns::Get(Board, Geometry, index, EStoneType::X, direction).GetLength();
+	RunLengths[1][direction][index] = (uint8)LinePatterns::Get(Board, Geometry, index, EStoneType::O, direction).GetLength();
+}
+
+void Rollout::UpdateThreats(int32 index)
+{
+	for (int32 player = 0; player < 2; ++player)
+	{
+		int32 length = 0;
+		for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+		{
+			length = FMath::Max(length, (int32)RunLengths[player][direction][index]);
+		}
+
+		if(length >= 5)
+		{
+			Fives[player].Set(index);
+		}
+		else
+		{
+			Fives[player].Clear(index);
+		}
+
+		if(length >= 4)
+		{
+			Fours[player].Set(index);
+		}
+		else
+		{
+			Fours[player].Clear(index);
+		}
+	}
+}
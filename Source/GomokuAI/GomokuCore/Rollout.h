@@ -0,0 +1,54 @@
+#pragma once
+
+#include "BitBoard.h"
+#include "LinePattern.h"
+
+/*
+ *  Random playout from a position, used by BoardState::Simulate.
+ *  Everything lives in the object itself, so a playout on the stack does no heap allocations.
+ *  For every move which can still be played the longest run each player would make there
+ *  is cached per direction and only the lines through a newly placed stone are reread,
+ *  so finding the forcing moves of a ply is a mask test instead of four line scans per move.
+ */
+class Rollout
+{
+
+public:
+
+	// moves are played in the given order unless one of them is forcing
+	Rollout(const BitBoard& board, const MoveList& moves);
+
+public:
+
+	// plays until someone completes five or the moves run out, returns the winner or Empty
+	EStoneType Play(EStoneType turn);
+
+private:
+
+	void Place(int32 index, EStoneType stoneType);
+
+	void UpdateRuns(int32 index, int32 direction);
+
+	void UpdateThreats(int32 index);
+
+private:
+
+	const BoardGeometry& Geometry;
+
+	BitBoard Board;
+
+	MoveList Moves;
+
+	// moves not played yet
+	CellMask Remaining;
+
+	// cells where a player would complete five, indexed by stone type - 1
+	CellMask Fives[2];
+
+	// cells where a player would make at least four
+	CellMask Fours[2];
+
+	// length of the run through each remaining move, per player and direction
+	uint8 RunLengths[2][LinePatterns::NumDirections][MaxBoardCells];
+
+};
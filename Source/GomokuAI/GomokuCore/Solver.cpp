@@ -0,0 +1,737 @@
+﻿#include "Solver.h"
+#include <chrono>
+#include <limits>
+#include <thread>
+#include "ThreadPool.h"
+#include "ThreatSearch.h"
+#include "Zobrist.h"
+
+Solver::Solver(float minTime, int32 minIteration) : Solver(minTime, minIteration, RandomGenerator::MakeSeed())
+{
+}
+
+Solver::Solver(float minTime, int32 minIteration, uint64 seed) : Random(seed)
+{
+	TimeToSolve = minTime;
+	IterationsToSolve = minIteration;
+	NumThreads = 1;
+	Pool = nullptr;
+	TreeRoot = nullptr;
+	CurrentEpoch = 0;
+	HasDeadline = false;
+	IsStopRequested = false;
+	IsDeadlinePassed = false;
+	NumCompletedIterations = 0;
+	IterationLimit = 0;
+	IsTreeFull = false;
+	SearchGeneration = 0;
+	UseSymmetry = false;
+	RootSymmetry = 0;
+	NodeLimit = 0;
+	SetMemoryBudget(DefaultMemoryBudget);
+}
+
+void Solver::Stop()
+{
+	IsStopRequested = true;
+}
+
+void Solver::SetThreadPool(ThreadPool* pool, int32 numThreads)
+{
+	Pool = pool;
+	NumThreads = FMath::Max(numThreads, 1);
+}
+
+void Solver::SetBudget(float timeToSolve, int32 iterationsToSolve)
+{
+	TimeToSolve = timeToSolve;
+	IterationsToSolve = iterationsToSolve;
+}
+
+void Solver::SetMemoryBudget(int32 megabytes)
+{
+	// the tables are sized by the next search, so a budget set right after construction does not
+	// allocate them twice
+	MemoryBudget = FMath::Max(megabytes, 1);
+	IsMemoryBudgetApplied = false;
+
+	// the table will forget the nodes, a new tree starts with the next Run
+	TreeRoot = nullptr;
+}
+
+void Solver::ApplyMemoryBudget()
+{
+	if(IsMemoryBudgetApplied)
+	{
+		return;
+	}
+	
+	const size_t budget = (size_t)MemoryBudget << 20;
+	Transpositions.Resize(budget / TableShare);
+	Proofs.Resize(budget / TableShare);
+
+	// an edge leads to almost every node, so each node is counted with one
+	const size_t nodeBytes = sizeof(BoardState) + sizeof(BoardStateEdge) + sizeof(BoardState*);
+	NodeLimit = (int32)((budget - Transpositions.GetSizeInBytes() - Proofs.GetSizeInBytes()) / nodeBytes);
+	IsMemoryBudgetApplied = true;
+}
+
+void Solver::SetUseSymmetry(bool useSymmetry)
+{
+	UseSymmetry = useSymmetry;
+
+	// the keys in the table change, a new tree starts with the next Run
+	TreeRoot = nullptr;
+}
+
+void Solver::Initialize(std::vector<EStoneType>& board, EStoneType turnStone)
+{
+	// nodes own no other memory, so resetting the arenas releases the whole tree at once
+	static_assert(std::is_trivially_destructible<BoardState>::value, "nodes are released without running destructors");
+	
+	Transpositions.Clear();
+	AllNodes.clear();
+	Nodes.Reset();
+	EdgeArrays.Reset();
+	IsTreeFull = false;
+	
+	TreeRoot = Nodes.Allocate(BitBoard(board), turnStone);
+	RootSymmetry = 0;
+	InsertBoardState(TreeRoot, GetTableKey(TreeRoot));
+}
+
+void Solver::PromoteRoot(std::vector<EStoneType>& board, EStoneType turnStone)
+{
+	// the old tree stays where it is, nodes no longer reachable are only freed by CollectGarbage
+	const BitBoard bitBoard(board);
+	const uint64 key = UseSymmetry ? Zobrist::CalculateCanonical(bitBoard, turnStone) : Zobrist::Calculate(bitBoard, turnStone);
+	BoardState* newRoot = TreeRoot != nullptr ? Transpositions.Find(key) : nullptr;
+	
+	if(newRoot == nullptr || !newRoot->IsExpanded())
+	{
+		Initialize(board, turnStone);
+		return;
+	}
+
+	// the node may have been created for a symmetric copy of board
+	const int32 symmetry = FindSymmetry(newRoot, bitBoard, turnStone);
+	if(symmetry == -1)
+	{
+		Initialize(board, turnStone);
+		return;
+	}
+	
+	TreeRoot = newRoot;
+	RootSymmetry = symmetry;
+}
+
+void Solver::CollectGarbage()
+{
+	CurrentEpoch++;
+	
+	std::vector<BoardState*> stack;
+	stack.push_back(TreeRoot);
+	TreeRoot->Epoch = CurrentEpoch;
+	
+	while(stack.size() != 0)
+	{
+		BoardState* node = stack.back();
+		stack.pop_back();
+
+		for (int32 i = 0; i < node->NumEdges; ++i)
+		{
+			BoardState* child = node->Edges[i].State;
+			if(child->Epoch != CurrentEpoch)
+			{
+				child->Epoch = CurrentEpoch;
+				stack.push_back(child);
+			}
+		}
+	}
+
+	int32 numKept = 0;
+	for (BoardState* node : AllNodes)
+	{
+		if(node->Epoch != CurrentEpoch)
+		{
+			Transpositions.Remove(GetTableKey(node), node);
+			FreeBoardState(node);
+		}
+		else
+		{
+			AllNodes[numKept++] = node;
+		}
+	}
+	AllNodes.resize(numKept);
+	IsTreeFull = false;
+}
+
+void Solver::Solve(float timeToSolve, int32 iterationsToSolve)
+{
+	// a deadline bounds a timed search, without one MaxIterations does
+	Search(timeToSolve, timeToSolve > 0 ? iterationsToSolve : FMath::Min(iterationsToSolve, MaxIterations));
+}
+
+void Solver::Search(float timeToSolve, int32 iterationLimit)
+{
+	const auto start = std::chrono::steady_clock::now();
+	std::atomic<int32> numIterations(0);
+	SearchGeneration++;
+	NumCompletedIterations = 0;
+	IterationLimit = iterationLimit;
+
+	// a time of 0 leaves only the iteration limit
+	HasDeadline = timeToSolve > 0;
+	Deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(timeToSolve));
+	IsDeadlinePassed = false;
+
+	if(Pool != nullptr && NumThreads > 1)
+	{
+		// the helper threads search the same tree, each with its own generator
+		std::vector<uint64> seeds(NumThreads);
+		for (auto& seed : seeds)
+		{
+			seed = Random.Next();
+		}
+
+		Pool->RunShared(NumThreads - 1, [this, &numIterations, &seeds](int32 threadIndex)
+		{
+			if(threadIndex == 0)
+			{
+				SearchLoop(Random, numIterations);
+				return;
+			}
+			
+			RandomGenerator random(seeds[threadIndex]);
+			SearchLoop(random, numIterations);
+		});
+	}
+	else
+	{
+		SearchLoop(Random, numIterations);
+	}
+	
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	UE_LOG(LogTemp, Warning, TEXT("iter %d time %d"), NumCompletedIterations.load(), (int32)elapsed.count());
+}
+
+void Solver::SearchLoop(RandomGenerator& random, std::atomic<int32>& numIterations)
+{
+	int32 numThreadIterations = 0;
+	
+	while (numIterations.fetch_add(1) < IterationLimit && !IsStopRequested.load(std::memory_order_relaxed) && !IsDeadlinePassed.load(std::memory_order_relaxed))
+	{
+		// more iterations can not change a proven result, or the score of a root which is a leaf
+		if(TreeRoot->IsProven() || TreeRoot->IsLeaf()) break;
+
+		// the clock is only read every few iterations, an iteration takes tens of microseconds
+		if(HasDeadline && numThreadIterations++ % ClockCheckInterval == 0 && std::chrono::steady_clock::now() >= Deadline)
+		{
+			IsDeadlinePassed = true;
+			break;
+		}
+
+		SearchIteration(random);
+		NumCompletedIterations++;
+	}
+}
+
+void Solver::SearchIteration(RandomGenerator& random)
+{
+	// find not expanded
+	BoardStateEdge rootEdge = BoardStateEdge{TreeRoot, -1};
+	std::vector<BoardStateEdge*> path;
+	path.push_back(&rootEdge);
+	TreeRoot->NumVisited++;
+	
+	BoardStateEdge* currentEdge = path[0];
+	bool isVisited = true;
+
+	while(currentEdge->State->IsExpanded() && !currentEdge->State->IsProven())
+	{
+		currentEdge = FindBestUcbChild(currentEdge->State);
+		isVisited = AddVirtualLoss(*currentEdge);
+		path.push_back(currentEdge);
+	}
+	
+	// if visited expand
+	if(currentEdge->Action == -1 || (isVisited && !currentEdge->State->IsLeaf()))
+	{
+		Expand(currentEdge->State);
+		if(currentEdge->State->IsExpanded() && !currentEdge->State->IsProven())
+		{
+			currentEdge = FindBestUcbChild(currentEdge->State);
+			AddVirtualLoss(*currentEdge);
+			path.push_back(currentEdge);
+		}
+	}
+
+	// simulate
+	float score = currentEdge->State->Simulate(random);
+	
+	// back prop
+	for (int32 i = path.size() - 1; i >= 1; --i)
+	{
+		UpdateEdge(*path[i], score);
+		score = 1 - score;
+	}
+
+	// a proof only travels up as long as each parent becomes proven by it
+	for (int32 i = path.size() - 1; i >= 1 && path[i]->State->IsProven(); --i)
+	{
+		ProveFromChildren(path[i - 1]->State);
+	}
+
+	AtomicAdd(TreeRoot->SumScore, score);
+}
+
+ std::unordered_map<int32, Evaluation> Solver::Run(std::vector<EStoneType>& board, EStoneType turnStone, int32 fromAction)
+{
+	RunStart = std::chrono::steady_clock::now();
+	Statistics = SearchStatistics();
+	NumCompletedIterations = 0;
+	
+	const std::unordered_map<int32, Evaluation> evaluations = ToBoardActions(EvaluateRoot(board, turnStone, fromAction));
+	
+	FinishStatistics(RunStart);
+	return evaluations;
+}
+
+std::unordered_map<int32, Evaluation> Solver::EvaluateRoot(std::vector<EStoneType>& board, EStoneType turnStone, int32 fromAction)
+{
+	// a Stop meant for pondering must not end this search
+	IsStopRequested = false;
+	ApplyMemoryBudget();
+	
+	if(fromAction != -1)
+	{
+		PromoteRoot(board, turnStone);
+
+		// only when the old trees leave too little room for this search, pondering collects them off the critical path
+		if(IsTreeFull || Nodes.GetNumAllocated() > NodeLimit / 2)
+		{
+			CollectGarbage();
+		}
+		StartStatistics();
+
+		// if can win just win and know it
+		if(TreeRoot->DecisiveMoveIndex != -1 && TreeRoot->LeafScore == 1)
+		{ 
+			return GetSolvedEvaluation(TreeRoot->DecisiveMoveIndex);
+		}
+
+		// a five can only be completed next to an existing stone, so only the candidates need checking
+		const MoveList candidates = MoveList::FromMask(TreeRoot->GenerateExpansionIndexes());
+
+		// check if can win
+		for (int i = 0; i < candidates.Num; ++i)
+		{
+			if(TreeRoot->IsWinningMove(candidates.Moves[i], TreeRoot->Turn, 5))
+			{
+				return GetSolvedEvaluation(candidates.Moves[i]);
+			}
+		}
+		
+		// if opponent can win play his move
+		for (int i = 0; i < candidates.Num; ++i)
+		{
+			if(TreeRoot->IsWinningMove(candidates.Moves[i], ChangeTurn(TreeRoot->Turn), 5))
+			{
+				return GetSolvedEvaluation(candidates.Moves[i]);
+			}
+		}
+	}
+	else
+	{
+		Initialize(board, turnStone);
+		StartStatistics();
+	}
+
+	// forced wins are found by the narrow search long before the tree would prove them
+	if(!TreeRoot->IsProven())
+	{
+		// a short time limit leaves most of it to the tree search
+		const float threatTime = TimeToSolve > 0 ? FMath::Min(MaxThreatTime, TimeToSolve / PreSearchShare) : MaxThreatTime;
+		const float proofTime = TimeToSolve > 0 ? FMath::Min(MaxProofTime, TimeToSolve / PreSearchShare) : MaxProofTime;
+		
+		ThreatSearch threats(MaxThreatNodes, threatTime);
+		std::vector<int32> line;
+		
+		if(threats.FindWin(TreeRoot->Board, TreeRoot->Turn, line))
+		{
+			return GetSolvedEvaluation(line[0]);
+		}
+
+		// a forcing position has only a few children, a proof search settles those faster than sampling
+		Expand(TreeRoot);
+		if(TreeRoot->NumEdges > 0 && TreeRoot->NumEdges <= MaxProofSearchChildren &&
+			Proofs.Solve(TreeRoot->Board, TreeRoot->Turn, MaxProofNodes, proofTime) == EProofResult::Proven)
+		{
+			return GetSolvedEvaluation(Proofs.GetBestMove());
+		}
+	}
+
+	if(TimeToSolve > 0)
+	{
+		const float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - RunStart).count();
+		Solve(FMath::Max(TimeToSolve - elapsed, MinSolveTime), IterationsToSolve);
+	}
+	else
+	{
+		Solve(0, IterationsToSolve);
+	}
+
+	Statistics.IsRootSolved = TreeRoot->IsProven();
+	return GetEdgeEvaluations(TreeRoot);
+}
+
+std::unordered_map<int32, Evaluation> Solver::GetSolvedEvaluation(int32 move)
+{
+	Statistics.IsRootSolved = true;
+	return std::unordered_map<int32, Evaluation>{{move, Evaluation{1000000, 1000000}}};
+}
+
+void Solver::Ponder(std::vector<EStoneType>& board, EStoneType turnStone, int32 fromAction)
+{
+	const auto start = std::chrono::steady_clock::now();
+	Statistics = SearchStatistics();
+	NumCompletedIterations = 0;
+	ApplyMemoryBudget();
+
+	// like in Run, only a known move leads from the old tree to board
+	if(fromAction != -1)
+	{
+		PromoteRoot(board, turnStone);
+	}
+	else
+	{
+		Initialize(board, turnStone);
+	}
+
+	// the opponent is thinking, so this is the time to free what the last moves left behind
+	CollectGarbage();
+	StartStatistics();
+
+	if(!TreeRoot->IsLeaf())
+	{
+		// no time or iteration limit, the opponent's move ends it through Stop
+		Search(0, std::numeric_limits<int32>::max());
+	}
+
+	FinishStatistics(start);
+}
+
+void Solver::StartStatistics()
+{
+	Statistics.NumNodesKept = Nodes.GetNumAllocated() - Statistics.NumNodesCreated;
+	Statistics.NumRootVisitsKept = TreeRoot->NumVisited.load();
+}
+
+void Solver::FinishStatistics(std::chrono::steady_clock::time_point start)
+{
+	Statistics.NumIterations = NumCompletedIterations.load();
+	Statistics.Seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+	Statistics.ReservedBytes = Nodes.GetReservedBytes() + EdgeArrays.GetReservedBytes() + Transpositions.GetSizeInBytes() + Proofs.GetSizeInBytes();
+}
+
+EStoneType Solver::ChangeTurn(EStoneType stoneType)
+{
+	if(stoneType == EStoneType::X)
+	{
+		return EStoneType::O;
+	}
+	
+	return EStoneType::X;
+}
+
+void Solver::Expand(BoardState* boardState)
+{
+	// Run answers with the edges of the root, so the root is expanded even past NodeLimit,
+	// which its children overshoot by at most one board
+	const bool isRoot = boardState == TreeRoot;
+	if(!isRoot && IsTreeFull.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+	
+	EExpansionState expected = EExpansionState::NotExpanded;
+	if(!boardState->ExpansionState.compare_exchange_strong(expected, EExpansionState::Expanding))
+	{
+		// another thread is expanding it, which does not take long
+		while(boardState->ExpansionState.load(std::memory_order_acquire) == EExpansionState::Expanding)
+		{
+			std::this_thread::yield();
+		}
+		return;
+	}
+
+	MoveList actions;
+	boardState->Expand(actions);
+
+	// the hashes of the symmetric copies of boardState give the ones of its children with one xor each
+	uint64 symmetricHashes[NumSymmetries];
+	const int16 (*symmetries)[MaxBoardCells] = BoardGeometry::Get(boardState->BoardWidth).Symmetries;
+	if(UseSymmetry && actions.Num != 0)
+	{
+		Zobrist::CalculateSymmetric(boardState->Board, boardState->Turn, symmetricHashes);
+	}
+
+	if(actions.Num != 0)
+	{
+		// the arenas and the table are shared by all threads
+		std::lock_guard<std::mutex> lock(GraphMutex);
+
+		if(!isRoot && Nodes.GetNumAllocated() + actions.Num > NodeLimit)
+		{
+			// the node stays a leaf of the tree and is simulated until CollectGarbage makes room
+			IsTreeFull = true;
+			boardState->ExpansionState.store(EExpansionState::NotExpanded, std::memory_order_release);
+			return;
+		}
+		
+		boardState->EdgeCapacity = actions.Num;
+		boardState->Edges = EdgeArrays.Allocate(boardState->EdgeCapacity);
+
+		for (int32 i = 0; i < actions.Num; ++i)
+		{
+			const int32 action = actions.Moves[i];
+			uint64 childKey = boardState->GetChildHash(action);
+			
+			if(UseSymmetry)
+			{
+				for (int32 symmetry = 0; symmetry < NumSymmetries; ++symmetry)
+				{
+					const uint64 symmetricHash = symmetricHashes[symmetry] ^ Zobrist::GetTurnKey() ^ Zobrist::GetStoneKey(symmetries[symmetry][action], boardState->Turn);
+					childKey = FMath::Min(childKey, symmetricHash);
+				}
+			}
+			
+			BoardState* child = Transpositions.Find(childKey);
+
+			// a colliding key gets a node of its own, which takes the entry over
+			if(child != nullptr)
+			{
+				BitBoard childBoard = boardState->Board;
+				childBoard.Set(action, boardState->Turn);
+				child = FindSymmetry(child, childBoard, ChangeTurn(boardState->Turn)) != -1 ? child : nullptr;
+			}
+			
+			if(child == nullptr)
+			{
+				child = Nodes.Allocate(boardState, action);
+				InsertBoardState(child, childKey);
+			}
+			else
+			{
+				Statistics.NumTranspositions++;
+			}
+
+			// insert a new edge from the boardState to the child
+			boardState->Edges[boardState->NumEdges++] = BoardStateEdge{child, actions.Moves[i]};
+		}
+	}
+
+	boardState->ExpansionState.store(EExpansionState::Expanded, std::memory_order_release);
+}
+
+void Solver::ProveFromChildren(BoardState* boardState)
+{
+	if(boardState->IsProven())
+	{
+		return;
+	}
+	
+	// the player to move picks a proven win if there is one and loses only when every move loses,
+	// which the edges only show when Expand kept all of them
+	bool isLost = boardState->HasAllChildren;
+	for (int32 i = 0; i < boardState->NumEdges; ++i)
+	{
+		const EProofState childProof = boardState->Edges[i].State->Proof.load(std::memory_order_acquire);
+		
+		if(childProof == EProofState::Win)
+		{
+			boardState->Proof.store(EProofState::Loss, std::memory_order_release);
+			return;
+		}
+		
+		isLost &= childProof == EProofState::Loss;
+	}
+
+	if(isLost)
+	{
+		boardState->Proof.store(EProofState::Win, std::memory_order_release);
+	}
+}
+
+float Solver::GetUcb(const BoardState* parent, const BoardState* boardState) const
+{
+	// a proven win is always taken and a proven loss only when nothing else is left
+	const EProofState proof = boardState->Proof.load(std::memory_order_relaxed);
+	if(proof != EProofState::Unknown)
+	{
+		if(proof == EProofState::Loss)
+		{
+			return -1000;
+		}
+		return 1000;
+	}
+
+	const int32 numVisited = boardState->NumVisited.load(std::memory_order_relaxed);
+	
+	if(numVisited == 0)
+		return 1000;
+
+	const float avg = boardState->SumScore.load(std::memory_order_relaxed) / numVisited;
+	const float expansion = 1.4f * FMath::Sqrt(FMath::Loge(parent->NumVisited.load(std::memory_order_relaxed)) / numVisited);
+	const float heuristics = boardState->Heuristic / (numVisited + 1);
+	
+	return avg + expansion + heuristics;
+}
+
+BoardStateEdge* Solver::FindBestUcbChild(BoardState* boardState)
+{
+	// only called for expanded states, they have at least one edge
+	BoardStateEdge* bestChild = &boardState->Edges[0];
+	float bestChildUCB = GetUcb(boardState, bestChild->State);
+	
+	for (int32 i = 1; i < boardState->NumEdges; ++i)
+	{
+		const float currentChildUCB = GetUcb(boardState, boardState->Edges[i].State);
+		
+		if(currentChildUCB > bestChildUCB)
+		{
+			bestChild = &boardState->Edges[i];
+			bestChildUCB = currentChildUCB;
+		}
+	}
+
+	return bestChild;
+}
+
+uint64 Solver::GetTableKey(const BoardState* boardState) const
+{
+	return UseSymmetry ? Zobrist::CalculateCanonical(boardState->Board, boardState->Turn) : boardState->Hash;
+}
+
+int32 Solver::FindSymmetry(const BoardState* node, const BitBoard& board, EStoneType turnStone) const
+{
+	if(node->Turn != turnStone)
+	{
+		return -1;
+	}
+
+	if(node->Board == board)
+	{
+		return 0;
+	}
+
+	for (int32 symmetry = 1; UseSymmetry && symmetry < NumSymmetries; ++symmetry)
+	{
+		if(node->Board == board.Transformed(symmetry))
+		{
+			return symmetry;
+		}
+	}
+	return -1;
+}
+
+void Solver::InsertBoardState(BoardState* boardState, uint64 key)
+{
+	boardState->Generation = SearchGeneration;
+	Statistics.NumNodesCreated++;
+	Transpositions.Insert(key, boardState, SearchGeneration);
+	AllNodes.push_back(boardState);
+}
+
+void Solver::FreeBoardState(BoardState* boardState)
+{
+	if(boardState->Edges != nullptr)
+	{
+		EdgeArrays.Free(boardState->Edges, boardState->EdgeCapacity);
+	}
+	Nodes.Free(boardState);
+}
+
+bool Solver::AddVirtualLoss(BoardStateEdge& edge)
+{
+	// the visit is counted when the edge is selected and its score only when the playout returns,
+	// so until then the edge looks like a loss to the other threads
+	edge.NumVisited++;
+	return edge.State->NumVisited.fetch_add(1) > 0;
+}
+
+void Solver::UpdateEdge(BoardStateEdge& edge, float scoreDelta)
+{
+	// the statistics of a node are the sum over all edges leading to it
+	AtomicAdd(edge.SumScore, scoreDelta);
+	AtomicAdd(edge.State->SumScore, scoreDelta);
+}
+
+void Solver::AtomicAdd(std::atomic<float>& value, float delta)
+{
+	float expected = value.load(std::memory_order_relaxed);
+	while(!value.compare_exchange_weak(expected, expected + delta, std::memory_order_relaxed))
+	{
+	}
+}
+
+std::unordered_map<int32, Evaluation> Solver::GetEdgeEvaluations(BoardState* boardState)
+{
+	if(!boardState->IsExpanded())
+	{
+		// a leaf which is not proven only suggests its move, with one visit of its own score
+		if(boardState->DecisiveMoveIndex != -1 && boardState->IsProven())
+		{
+			return std::unordered_map<int32, Evaluation>{{boardState->DecisiveMoveIndex, Evaluation{1000000, 1000000}}};
+		}
+		if(boardState->DecisiveMoveIndex != -1)
+		{
+			return std::unordered_map<int32, Evaluation>{{boardState->DecisiveMoveIndex, Evaluation{1, 1 - boardState->LeafScore}}};
+		}
+		
+		return std::unordered_map<int32, Evaluation>{};
+	}
+
+	// a proven win is the only move worth reporting, proven losses are left out unless all moves lose
+	const bool isLost = boardState->Proof.load() == EProofState::Win;
+	
+	std::unordered_map<int32, Evaluation> evaluations;
+	for (int32 i = 0; i < boardState->NumEdges; ++i)
+	{
+		const BoardStateEdge& edge = boardState->Edges[i];
+		const EProofState childProof = edge.State->Proof.load();
+
+		if(childProof == EProofState::Win)
+		{
+			return std::unordered_map<int32, Evaluation>{{edge.Action, Evaluation{1000000, 1000000}}};
+		}
+
+		if(childProof != EProofState::Loss || isLost)
+		{
+			evaluations.emplace(edge.Action, Evaluation{edge.NumVisited.load(), edge.SumScore.load()});
+		}
+	}
+	return evaluations;
+}
+
+std::unordered_map<int, Evaluation> Solver::GetRootEdgeEvaluations()
+{
+	return ToBoardActions(GetEdgeEvaluations(TreeRoot));
+}
+
+std::unordered_map<int32, Evaluation> Solver::ToBoardActions(const std::unordered_map<int32, Evaluation>& evaluations) const
+{
+	if(RootSymmetry == 0)
+	{
+		return evaluations;
+	}
+
+	const int16* cells = BoardGeometry::Get(TreeRoot->BoardWidth).Symmetries[BoardGeometry::GetInverseSymmetry(RootSymmetry)];
+	
+	std::unordered_map<int32, Evaluation> boardEvaluations;
+	for (const auto& evaluation : evaluations)
+	{
+		boardEvaluations.emplace(cells[evaluation.first], evaluation.second);
+	}
+	return boardEvaluations;
+}
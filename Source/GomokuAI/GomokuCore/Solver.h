@@ -0,0 +1,259 @@
+﻿#pragma once
+
+#include "BoardState.h"
+#include "NodeArena.h"
+#include "ProofNumberSearch.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+class BoardState;
+class ThreadPool;
+
+struct Evaluation
+{
+	int32 NumVisited;
+	
+	float SumScore;
+};
+
+// what the last Run or Ponder did
+struct SearchStatistics
+{
+	int32 NumIterations = 0;
+
+	float Seconds = 0;
+
+	// nodes the search allocated, and expansions which found the child in the table instead
+	int32 NumNodesCreated = 0;
+
+	int32 NumTranspositions = 0;
+
+	// nodes of earlier searches still allocated when the search started, and the visits of the root among them
+	int32 NumNodesKept = 0;
+
+	int32 NumRootVisitsKept = 0;
+
+	// arenas and tables, they never shrink so this is also the most the solver held so far
+	size_t ReservedBytes = 0;
+
+	// Run's answer is decided rather than sampled: a five to complete or block, a forced win of the threat
+	// or proof search, or a root the tree search proved won or lost
+	bool IsRootSolved = false;
+};
+
+class Solver
+{
+
+public:
+
+	// seeded from std::random_device
+	Solver(float minTime, int32 minIteration);
+
+	// fixed seed for runs which repeat move for move
+	Solver(float minTime, int32 minIteration, uint64 seed);
+
+	// ends a running Solve or Ponder after the current iterations, safe to call from any thread.
+	// Ponder started after the call ends at once, Run clears the request
+	void Stop();
+
+	// limits of the following Runs, the time covers all of Run including the threat and proof searches
+	void SetBudget(float timeToSolve, int32 iterationsToSolve);
+
+	// Solve searches the one tree with numThreads threads, the calling one and helpers from pool
+	void SetThreadPool(ThreadPool* pool, int32 numThreads);
+
+	// memory for the nodes, edges and transposition tables together, not to be called while searching.
+	// When it is full the leaves are simulated without being expanded until old nodes are collected
+	void SetMemoryBudget(int32 megabytes);
+
+	// when on, the eight rotations and reflections of a position share one node, so their statistics are shared.
+	// Not to be called while searching
+	void SetUseSymmetry(bool useSymmetry);
+
+	// a time of 0 is no time limit, the iterations are then capped at MaxIterations
+	void Solve(float timeToSolve, int32 iterationsToSolve);
+	
+	void Initialize(std::vector<EStoneType>& board, EStoneType turnStone);
+
+	 std::unordered_map<int32, Evaluation> Run(std::vector<EStoneType>& board, EStoneType turnStone, int32 fromAction);
+
+	// moves the root to board, the position after our own move fromAction, and searches it until Stop,
+	// so the subtree of the opponent's reply already has statistics when Run is called with it.
+	// With a fromAction of -1 the search starts a new tree
+	void Ponder(std::vector<EStoneType>& board, EStoneType turnStone, int32 fromAction);
+
+	std::unordered_map<int, Evaluation> GetEdgeEvaluations(BoardState* boardState);
+
+	// the statistics are atomics, so this gives the best moves so far while Solve is still running.
+	// Unlike GetEdgeEvaluations the actions are cells of the board given to Run
+	std::unordered_map<int, Evaluation> GetRootEdgeEvaluations();
+
+	const SearchStatistics& GetStatistics() const { return Statistics; }
+
+public:
+	
+	static EStoneType ChangeTurn(EStoneType stoneType);
+
+private:
+
+	// parent is the node selecting boardState, its visits are the exploration term's total
+	float GetUcb(const BoardState* parent, const BoardState* boardState) const;
+	
+	BoardStateEdge* FindBestUcbChild(BoardState* boardState);
+
+	// Solve without MaxIterations, iterationLimit and timeToSolve are the only bounds besides Stop
+	void Search(float timeToSolve, int32 iterationLimit);
+
+	void SearchLoop(RandomGenerator& random, std::atomic<int32>& numIterations);
+
+	void SearchIteration(RandomGenerator& random);
+
+	// the evaluations of the root for Run, with the actions of the root's own board
+	// fills the statistics of the nodes kept from earlier searches once the root is in place
+	void StartStatistics();
+
+	void FinishStatistics(std::chrono::steady_clock::time_point start);
+
+	std::unordered_map<int32, Evaluation> EvaluateRoot(std::vector<EStoneType>& board, EStoneType turnStone, int32 fromAction);
+
+	// the single evaluation Run answers a solved root with
+	std::unordered_map<int32, Evaluation> GetSolvedEvaluation(int32 move);
+
+	// maps actions on the board of the root back to the board given to Run
+	std::unordered_map<int32, Evaluation> ToBoardActions(const std::unordered_map<int32, Evaluation>& evaluations) const;
+
+	// the key of boardState in Transpositions
+	uint64 GetTableKey(const BoardState* boardState) const;
+
+	// the symmetry which turns board into the one of node, -1 when node holds another position.
+	// Keys of different positions can collide, so a node found in Transpositions is checked with it
+	int32 FindSymmetry(const BoardState* node, const BitBoard& board, EStoneType turnStone) const;
+
+	void InsertBoardState(BoardState* boardState, uint64 key);
+
+	// sizes the tables and the node limit for MemoryBudget, when SetMemoryBudget changed it
+	void ApplyMemoryBudget();
+
+	void FreeBoardState(BoardState* boardState);
+
+	// returns whether the child was visited before
+	bool AddVirtualLoss(BoardStateEdge& edge);
+
+	void UpdateEdge(BoardStateEdge& edge, float scoreDelta);
+
+	static void AtomicAdd(std::atomic<float>& value, float delta);
+
+	void Expand(BoardState* boardState);
+
+	// proves boardState from the proofs of its children, when they decide it
+	void ProveFromChildren(BoardState* boardState);
+
+	// makes the node of board the root in O(1), or starts a new tree when there is none
+	void PromoteRoot(std::vector<EStoneType>& board, EStoneType turnStone);
+
+	// frees the nodes which can not be reached from the root anymore
+	void CollectGarbage();
+	
+private:
+	
+	// finds transpositions when expanding and the new root in PromoteRoot, does not hold every node
+	TranspositionTable Transpositions;
+
+	// solves forcing roots in Run, its table is kept across moves
+	ProofNumberSearch Proofs;
+
+	// every allocated node, swept by CollectGarbage
+	std::vector<BoardState*> AllNodes;
+
+	NodeArena<BoardState> Nodes;
+
+	ArrayArena<BoardStateEdge> EdgeArrays;
+
+	// guards Transpositions, AllNodes, Nodes and EdgeArrays while the search threads expand nodes
+	std::mutex GraphMutex;
+
+	int32 NodeLimit;
+
+	// megabytes, see SetMemoryBudget
+	int32 MemoryBudget;
+
+	bool IsMemoryBudgetApplied;
+
+	// set when an expansion would go over NodeLimit, cleared when nodes are freed
+	std::atomic<bool> IsTreeFull;
+
+	// counts the searches, see TranspositionTable::Insert
+	uint32 SearchGeneration;
+
+	// nodes are found by the canonical hash of their position instead of its own hash
+	bool UseSymmetry;
+
+	BoardState* TreeRoot;
+
+	// the board of TreeRoot is the board given to Run transformed by it, a node keeps the
+	// orientation it was created with when it is reached again by a symmetric position
+	int32 RootSymmetry;
+
+	// nodes reached from the root are marked with it by CollectGarbage
+	uint32 CurrentEpoch;
+
+	// seconds Run may take, 0 for no limit
+	float TimeToSolve;
+	
+	int32 IterationsToSolve;
+
+	RandomGenerator Random;
+
+	std::chrono::steady_clock::time_point Deadline;
+
+	std::chrono::steady_clock::time_point RunStart;
+
+	bool HasDeadline;
+
+	int32 IterationLimit;
+
+	std::atomic<bool> IsStopRequested;
+
+	std::atomic<bool> IsDeadlinePassed;
+
+	std::atomic<int32> NumCompletedIterations;
+
+	// counted under GraphMutex
+	SearchStatistics Statistics;
+
+	static constexpr int32 ClockCheckInterval = 16;
+
+	// bounds a Solve without a time limit
+	static constexpr int32 MaxIterations = 100000;
+
+	// budget of the threat search Run does before the tree search
+	static constexpr int32 MaxThreatNodes = 20000;
+
+	static constexpr float MaxThreatTime = 0.05f;
+
+	// the proof search only runs on roots with at most this many children
+	static constexpr int32 MaxProofSearchChildren = 6;
+
+	static constexpr int32 MaxProofNodes = 2000;
+
+	static constexpr float MaxProofTime = 0.05f;
+
+	// with a time limit the threat and proof searches each take at most this part of it
+	static constexpr int32 PreSearchShare = 4;
+
+	// the tree search gets at least this long even when the searches before it used up the time
+	static constexpr float MinSolveTime = 0.001f;
+
+	static constexpr int32 DefaultMemoryBudget = 64;
+
+	// part of the budget given to each of the transposition tables, the rest holds nodes
+	static constexpr int32 TableShare = 8;
+
+	ThreadPool* Pool;
+
+	int32 NumThreads;
+	
+};
@@ -0,0 +1,11 @@
+﻿#pragma once
+
+#include "GomokuTypes.h"
+
+UENUM(BlueprintType, Blueprintable)
+enum class EStoneType : uint8
+{
+	Empty = 0,
+	X = 1,
+	O = 2
+};
@@ -0,0 +1,127 @@
+#include "ThreadPool.h"
+#include <memory>
+
+ThreadPool::ThreadPool(int32 numThreads)
+{
+	NumRunning = 0;
+	IsStopping = false;
+
+	for (int32 i = 0; i < numThreads; ++i)
+	{
+		Threads.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		IsStopping = true;
+	}
+	TaskAdded.notify_all();
+
+	for (auto& thread : Threads)
+	{
+		thread.join();
+	}
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Tasks.push_back(std::move(task));
+	}
+	TaskAdded.notify_one();
+}
+
+bool ThreadPool::IsIdle()
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	return Tasks.empty() && NumRunning == 0;
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(Mutex);
+	TaskFinished.wait(lock, [this]() { return Tasks.empty() && NumRunning == 0; });
+}
+
+void ThreadPool::RunShared(int32 numHelpers, const std::function<void(int32)>& task)
+{
+	struct SharedRun
+	{
+		std::mutex Mutex;
+
+		std::condition_variable Finished;
+
+		bool IsClosed = false;
+
+		int32 NumRunning = 0;
+	};
+
+	const std::shared_ptr<SharedRun> run = std::make_shared<SharedRun>();
+
+	for (int32 i = 1; i <= numHelpers; ++i)
+	{
+		Submit([run, &task, i]()
+		{
+			{
+				std::lock_guard<std::mutex> lock(run->Mutex);
+				if(run->IsClosed)
+				{
+					// the caller has returned, task may not exist anymore
+					return;
+				}
+				run->NumRunning++;
+			}
+
+			task(i);
+
+			std::lock_guard<std::mutex> lock(run->Mutex);
+			run->NumRunning--;
+			run->Finished.notify_all();
+		});
+	}
+
+	task(0);
+
+	std::unique_lock<std::mutex> lock(run->Mutex);
+	run->IsClosed = true;
+	run->Finished.wait(lock, [&run]() { return run->NumRunning == 0; });
+}
+
+int32 ThreadPool::GetDefaultNumThreads()
+{
+	const int32 numThreads = (int32)std::thread::hardware_concurrency();
+	return numThreads > 0 ? numThreads : 1;
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while(true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(Mutex);
+			TaskAdded.wait(lock, [this]() { return IsStopping || !Tasks.empty(); });
+
+			if(IsStopping && Tasks.empty())
+			{
+				return;
+			}
+
+			task = std::move(Tasks.front());
+			Tasks.pop_front();
+			NumRunning++;
+		}
+
+		task();
+
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			NumRunning--;
+		}
+		TaskFinished.notify_all();
+	}
+}
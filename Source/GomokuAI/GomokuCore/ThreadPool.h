@@ -0,0 +1,69 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "GomokuTypes.h"
+
+/*
+ *  Long lived worker threads for the search, created once and reused for every move.
+ */
+class ThreadPool
+{
+
+public:
+
+	explicit ThreadPool(int32 numThreads);
+
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+public:
+
+	void Submit(std::function<void()> task);
+
+	// true when no task is queued or running
+	bool IsIdle();
+
+	// blocks until no task is queued or running
+	void Wait();
+
+	/*
+	 *  Runs task(0) on the calling thread and task(1..numHelpers) on pool threads, for work which
+	 *  any number of threads can share. Returns when task(0) and every helper which started are done,
+	 *  helpers which did not get a thread by then are skipped, so a busy pool can not deadlock the caller.
+	 */
+	void RunShared(int32 numHelpers, const std::function<void(int32)>& task);
+
+	int32 GetNumThreads() const { return (int32)Threads.size(); }
+
+	// std::thread::hardware_concurrency, at least 1
+	static int32 GetDefaultNumThreads();
+
+private:
+
+	void WorkerLoop();
+
+private:
+
+	std::vector<std::thread> Threads;
+
+	std::deque<std::function<void()>> Tasks;
+
+	std::mutex Mutex;
+
+	std::condition_variable TaskAdded;
+
+	std::condition_variable TaskFinished;
+
+	int32 NumRunning;
+
+	bool IsStopping;
+
+};
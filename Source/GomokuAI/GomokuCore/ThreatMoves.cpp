@@ -0,0 +1,242 @@
+#include "ThreatMoves.h"
+#include "BoardState.h"
+#include "LinePattern.h"
+
+CellMask ThreatMoves::GetFiveCells(const BitBoard& board, EStoneType stoneType)
+{
+	CellMask cells;
+
+	board.GetNeighbourhood().ForEachIndex([&](int32 index)
+	{
+		if(BoardState::FindSequence(board, index, stoneType, 5))
+		{
+			cells.Set(index);
+		}
+	});
+
+	return cells;
+}
+
+MoveList ThreatMoves::GetAttacks(BitBoard& board, const BoardGeometry& geometry, EStoneType attacker, bool allowThrees)
+{
+	// a four of the defender has to be blocked first, the attacker's threats may still stand after it
+	const CellMask defenderWins = GetFiveCells(board, GetOpponent(attacker));
+	MoveList moves;
+
+	if(!defenderWins.IsEmpty())
+	{
+		if(defenderWins.Count() == 1)
+		{
+			moves.Add(defenderWins.GetFirst());
+		}
+		return moves;
+	}
+
+	const CellMask fours = GetFourMoves(board, geometry, attacker);
+	moves = MoveList::FromMask(fours);
+
+	if(allowThrees)
+	{
+		const MoveList threes = MoveList::FromMask(GetThreeMoves(board, geometry, attacker).AndNot(fours));
+		for (int32 i = 0; i < threes.Num; ++i)
+		{
+			moves.Add(threes.Moves[i]);
+		}
+	}
+
+	return moves;
+}
+
+CellMask ThreatMoves::GetDefences(BitBoard& board, const BoardGeometry& geometry, EStoneType attacker)
+{
+	const EStoneType defender = GetOpponent(attacker);
+	CellMask replies;
+	const CellMask attackerWins = GetFiveCells(board, attacker);
+
+	if(!attackerWins.IsEmpty())
+	{
+		// with two fives one block is as good as any other move
+		replies.Set(attackerWins.GetFirst());
+		return replies;
+	}
+
+	const CellMask openFours = GetOpenFourCells(board, geometry, attacker, board.GetNeighbourhood());
+	if(openFours.IsEmpty())
+	{
+		return replies;
+	}
+
+	CellMask candidates = openFours;
+	openFours.ForEachIndex([&](int32 index)
+	{
+		candidates |= GetLineCells(board, geometry, index);
+	});
+
+	// stones of the defender never make a new open four, so only the known ones are checked again
+	const MoveList candidateMoves = MoveList::FromMask(candidates);
+	for (int32 i = 0; i < candidateMoves.Num; ++i)
+	{
+		board.Set(candidateMoves.Moves[i], defender);
+		if(GetOpenFourCells(board, geometry, attacker, openFours).IsEmpty())
+		{
+			replies.Set(candidateMoves.Moves[i]);
+		}
+		board.Set(candidateMoves.Moves[i], EStoneType::Empty);
+	}
+
+	// any other move lets the attacker make an open four, which wins unless the defender has a four
+	replies |= GetFourMoves(board, geometry, defender);
+
+	if(replies.IsEmpty())
+	{
+		replies.Set(candidateMoves.Moves[0]);
+	}
+
+	return replies;
+}
+
+CellMask ThreatMoves::GetOpenFourCells(BitBoard& board, const BoardGeometry& geometry, EStoneType stoneType, const CellMask& cells)
+{
+	CellMask openFours;
+
+	cells.ForEachIndex([&](int32 index)
+	{
+		if(!board.IsEmpty(index) || !HasWindowStones(board, geometry, index, stoneType, 3))
+		{
+			return;
+		}
+
+		board.Set(index, stoneType);
+		if(GetFiveCellsThrough(board, geometry, index, stoneType).Count() >= 2)
+		{
+			openFours.Set(index);
+		}
+		board.Set(index, EStoneType::Empty);
+	});
+
+	return openFours;
+}
+
+CellMask ThreatMoves::GetFiveCellsThrough(const BitBoard& board, const BoardGeometry& geometry, int32 index, EStoneType stoneType)
+{
+	CellMask cells;
+
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		if(CountWindowStones(board, geometry, index, stoneType, direction) < 3)
+		{
+			continue;
+		}
+
+		const int32 step = LinePatterns::GetStep(direction, board.GetWidth());
+		const uint32 onBoard = geometry.LineWindows[direction][index];
+
+		for (int32 position = 0; position < 8; ++position)
+		{
+			const int32 cell = index + (position < 4 ? position - 4 : position - 3) * step;
+
+			if((onBoard & (1u << position)) && board.IsEmpty(cell) && LinePatterns::Get(board, geometry, cell, stoneType, direction).GetLength() >= 5)
+			{
+				cells.Set(cell);
+			}
+		}
+	}
+
+	return cells;
+}
+
+CellMask ThreatMoves::GetFourMoves(BitBoard& board, const BoardGeometry& geometry, EStoneType stoneType)
+{
+	CellMask moves;
+
+	board.GetNeighbourhood().ForEachIndex([&](int32 index)
+	{
+		if(!HasWindowStones(board, geometry, index, stoneType, 3))
+		{
+			return;
+		}
+
+		board.Set(index, stoneType);
+		if(!GetFiveCellsThrough(board, geometry, index, stoneType).IsEmpty())
+		{
+			moves.Set(index);
+		}
+		board.Set(index, EStoneType::Empty);
+	});
+
+	return moves;
+}
+
+CellMask ThreatMoves::GetThreeMoves(BitBoard& board, const BoardGeometry& geometry, EStoneType stoneType)
+{
+	CellMask moves;
+
+	board.GetNeighbourhood().ForEachIndex([&](int32 index)
+	{
+		if(!HasWindowStones(board, geometry, index, stoneType, 2))
+		{
+			return;
+		}
+
+		board.Set(index, stoneType);
+		if(!GetOpenFourCells(board, geometry, stoneType, GetLineCells(board, geometry, index)).IsEmpty())
+		{
+			moves.Set(index);
+		}
+		board.Set(index, EStoneType::Empty);
+	});
+
+	return moves;
+}
+
+CellMask ThreatMoves::GetLineCells(const BitBoard& board, const BoardGeometry& geometry, int32 index)
+{
+	CellMask cells;
+
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		const int32 step = LinePatterns::GetStep(direction, board.GetWidth());
+		const uint32 onBoard = geometry.LineWindows[direction][index];
+
+		for (int32 position = 0; position < 8; ++position)
+		{
+			const int32 cell = index + (position < 4 ? position - 4 : position - 3) * step;
+
+			if((onBoard & (1u << position)) && board.IsEmpty(cell))
+			{
+				cells.Set(cell);
+			}
+		}
+	}
+
+	return cells;
+}
+
+bool ThreatMoves::HasWindowStones(const BitBoard& board, const BoardGeometry& geometry, int32 index, EStoneType stoneType, int32 minStones)
+{
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		if(CountWindowStones(board, geometry, index, stoneType, direction) >= minStones)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 ThreatMoves::CountWindowStones(const BitBoard& board, const BoardGeometry& geometry, int32 index, EStoneType stoneType, int32 direction)
+{
+	const CellMask& own = board.GetStones(stoneType);
+	const int32 step = LinePatterns::GetStep(direction, board.GetWidth());
+	const uint32 onBoard = geometry.LineWindows[direction][index];
+
+	int32 count = 0;
+	for (int32 position = 0; position < 8; ++position)
+	{
+		if(onBoard & (1u << position))
+		{
+			count += own.Test(index + (position < 4 ? position - 4 : position - 3) * step) ? 1 : 0;
+		}
+	}
+	return count;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "BitBoard.h"
+
+/*
+ *  The moves of a search which only plays threats, shared by ThreatSearch and ProofNumberSearch.
+ *  The attacker tries its fours and threes, the defender every reply which does not lose at once
+ *  to a five or an open four. A win found in these moves is a win against any defence, but no win
+ *  in them only means there is no win by threats.
+ *  The board is changed while a move is tried and restored before returning.
+ */
+class ThreatMoves
+{
+
+public:
+
+	// empty cells where stoneType completes five
+	static CellMask GetFiveCells(const BitBoard& board, EStoneType stoneType);
+
+	// the attacker to move without a five of its own. The block of a single five of the defender,
+	// else the attacker's fours followed by its threes when allowThrees is set.
+	// Empty when the defender has two fives
+	static MoveList GetAttacks(BitBoard& board, const BoardGeometry& geometry, EStoneType attacker, bool allowThrees);
+
+	// the defender to move without a five of its own, after a move of the attacker.
+	// Empty when the attacker has neither a five nor an open four to make, so the move was no threat
+	static CellMask GetDefences(BitBoard& board, const BoardGeometry& geometry, EStoneType attacker);
+
+private:
+
+	// empty cells where stoneType makes five in two places at once, an open four or a double four
+	static CellMask GetOpenFourCells(BitBoard& board, const BoardGeometry& geometry, EStoneType stoneType, const CellMask& cells);
+
+	// empty cells where stoneType completes five on the lines through index
+	static CellMask GetFiveCellsThrough(const BitBoard& board, const BoardGeometry& geometry, int32 index, EStoneType stoneType);
+
+	// moves of stoneType which leave it a cell to complete five
+	static CellMask GetFourMoves(BitBoard& board, const BoardGeometry& geometry, EStoneType stoneType);
+
+	// moves of stoneType which leave it a cell to make an open four
+	static CellMask GetThreeMoves(BitBoard& board, const BoardGeometry& geometry, EStoneType stoneType);
+
+	// empty cells of the line windows around index
+	static CellMask GetLineCells(const BitBoard& board, const BoardGeometry& geometry, int32 index);
+
+	static bool HasWindowStones(const BitBoard& board, const BoardGeometry& geometry, int32 index, EStoneType stoneType, int32 minStones);
+
+	// own stones in the line window around index, which a five through index needs four of
+	static int32 CountWindowStones(const BitBoard& board, const BoardGeometry& geometry, int32 index, EStoneType stoneType, int32 direction);
+
+	static EStoneType GetOpponent(EStoneType stoneType) { return stoneType == EStoneType::X ? EStoneType::O : EStoneType::X; }
+
+};
@@ -0,0 +1,161 @@
+#include "ThreatSearch.h"
+#include <algorithm>
+#include "ThreatMoves.h"
+
+ThreatSearch::ThreatSearch(int32 maxNodes, float maxTime)
+{
+	Geometry = nullptr;
+	Attacker = EStoneType::X;
+	Defender = EStoneType::O;
+	AllowThrees = false;
+	MaxNodes = maxNodes;
+	MaxTime = maxTime;
+	NumNodes = 0;
+	IsAborted = false;
+}
+
+bool ThreatSearch::FindWin(const BitBoard& board, EStoneType turn, std::vector<int32>& outLine)
+{
+	StartBudget();
+
+	// fours leave a single reply, so the deeper VCF costs less than a shallow VCT
+	return RunSearch(board, turn, false, MaxFourDepth, outLine) || RunSearch(board, turn, true, MaxThreeDepth, outLine);
+}
+
+bool ThreatSearch::Search(const BitBoard& board, EStoneType turn, bool allowThrees, int32 maxDepth, std::vector<int32>& outLine)
+{
+	StartBudget();
+	return RunSearch(board, turn, allowThrees, maxDepth, outLine);
+}
+
+void ThreatSearch::StartBudget()
+{
+	NumNodes = 0;
+	IsAborted = false;
+	Deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(MaxTime));
+}
+
+bool ThreatSearch::RunSearch(const BitBoard& board, EStoneType turn, bool allowThrees, int32 maxDepth, std::vector<int32>& outLine)
+{
+	Board = board;
+	Geometry = &BoardGeometry::Get(board.GetWidth());
+	Attacker = turn;
+	Defender = GetOpponent(turn);
+	AllowThrees = allowThrees;
+
+	for (int32 depth = 1; depth <= maxDepth && !IsAborted; ++depth)
+	{
+		// the line is collected from the last move back
+		outLine.clear();
+		if(SearchAttack(depth, outLine))
+		{
+			std::reverse(outLine.begin(), outLine.end());
+			return true;
+		}
+	}
+
+	outLine.clear();
+	return false;
+}
+
+bool ThreatSearch::SearchAttack(int32 depth, std::vector<int32>& outLine)
+{
+	if(IsOutOfBudget())
+	{
+		return false;
+	}
+
+	const CellMask wins = ThreatMoves::GetFiveCells(Board, Attacker);
+	if(!wins.IsEmpty())
+	{
+		outLine.push_back(wins.GetFirst());
+		return true;
+	}
+
+	if(depth == 0)
+	{
+		return false;
+	}
+
+	// a three needs another move to become an open four
+	const MoveList moves = ThreatMoves::GetAttacks(Board, *Geometry, Attacker, AllowThrees && depth > 1);
+
+	for (int32 i = 0; i < moves.Num; ++i)
+	{
+		Board.Set(moves.Moves[i], Attacker);
+		const bool isWin = SearchDefence(depth - 1, outLine);
+		Board.Set(moves.Moves[i], EStoneType::Empty);
+
+		if(isWin)
+		{
+			outLine.push_back(moves.Moves[i]);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ThreatSearch::SearchDefence(int32 depth, std::vector<int32>& outLine)
+{
+	if(IsOutOfBudget())
+	{
+		return false;
+	}
+
+	if(!ThreatMoves::GetFiveCells(Board, Defender).IsEmpty())
+	{
+		return false;
+	}
+
+	const CellMask replies = ThreatMoves::GetDefences(Board, *Geometry, Attacker);
+	if(replies.IsEmpty())
+	{
+		return false;
+	}
+
+	std::vector<int32> firstLine;
+	const MoveList replyMoves = MoveList::FromMask(replies);
+
+	for (int32 i = 0; i < replyMoves.Num; ++i)
+	{
+		std::vector<int32> replyLine;
+
+		Board.Set(replyMoves.Moves[i], Defender);
+		const bool isWin = SearchAttack(depth, replyLine);
+		Board.Set(replyMoves.Moves[i], EStoneType::Empty);
+
+		if(!isWin)
+		{
+			return false;
+		}
+
+		if(i == 0)
+		{
+			replyLine.push_back(replyMoves.Moves[i]);
+			firstLine = replyLine;
+		}
+	}
+
+	// every reply loses, the line follows the first one
+	outLine.insert(outLine.end(), firstLine.begin(), firstLine.end());
+	return true;
+}
+
+bool ThreatSearch::IsOutOfBudget()
+{
+	NumNodes++;
+
+	if(MaxNodes > 0 && NumNodes > MaxNodes)
+	{
+		IsAborted = true;
+	}
+
+	// the clock is only read every few nodes, a node takes a few microseconds
+	if(MaxTime > 0 && NumNodes % ClockCheckInterval == 0 && std::chrono::steady_clock::now() >= Deadline)
+	{
+		IsAborted = true;
+	}
+
+	return IsAborted;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include "BitBoard.h"
+
+/*
+ *  Narrow search for forced wins which only tries the attacker's threats.
+ *  A victory by continuous fours (VCF) leaves the defender one reply per move, so it is exact.
+ *  A victory by threats (VCT) also plays threes, the defender then tries every cell which stops
+ *  all open fours the attacker could make and every four of their own. Any other reply loses
+ *  to the open four, so VCT wins are proven as well.
+ *  Both are iteratively deepened, so the shortest win within the budget is found first.
+ */
+class ThreatSearch
+{
+
+public:
+
+	// a budget of 0 nodes or seconds is no limit on it
+	ThreatSearch(int32 maxNodes, float maxTime);
+
+public:
+
+	// tries VCF and then VCT for turn, outLine gets the moves of both sides starting with turn's
+	bool FindWin(const BitBoard& board, EStoneType turn, std::vector<int32>& outLine);
+
+	// depth counts the attacker's moves, threes are only played when allowThrees is set
+	bool Search(const BitBoard& board, EStoneType turn, bool allowThrees, int32 maxDepth, std::vector<int32>& outLine);
+
+	int32 GetNumNodes() const { return NumNodes; }
+
+	static constexpr int32 MaxFourDepth = 12;
+
+	static constexpr int32 MaxThreeDepth = 4;
+
+	static constexpr int32 ClockCheckInterval = 64;
+
+private:
+
+	void StartBudget();
+
+	bool RunSearch(const BitBoard& board, EStoneType turn, bool allowThrees, int32 maxDepth, std::vector<int32>& outLine);
+
+	// attacker to move
+	bool SearchAttack(int32 depth, std::vector<int32>& outLine);
+
+	// defender to move after the attacker's threat
+	bool SearchDefence(int32 depth, std::vector<int32>& outLine);
+
+	// the node budget and the clock, checked once per node
+	bool IsOutOfBudget();
+
+	static EStoneType GetOpponent(EStoneType stoneType) { return stoneType == EStoneType::X ? EStoneType::O : EStoneType::X; }
+
+private:
+
+	BitBoard Board;
+
+	const BoardGeometry* Geometry;
+
+	EStoneType Attacker;
+
+	EStoneType Defender;
+
+	bool AllowThrees;
+
+	int32 MaxNodes;
+
+	float MaxTime;
+
+	int32 NumNodes;
+
+	bool IsAborted;
+
+	std::chrono::steady_clock::time_point Deadline;
+
+};
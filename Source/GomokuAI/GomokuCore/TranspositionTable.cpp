@@ -0,0 +1,90 @@
+#include "TranspositionTable.h"
+#include "BoardState.h"
+
+TranspositionTable::TranspositionTable() : NumBuckets(0)
+{
+	Resize(sizeof(Bucket));
+}
+
+void TranspositionTable::Resize(size_t sizeInBytes)
+{
+	uint64 numBuckets = 1;
+	while(numBuckets * 2 * sizeof(Bucket) <= sizeInBytes)
+	{
+		numBuckets *= 2;
+	}
+
+	if(numBuckets != NumBuckets)
+	{
+		// a plain new[] would not align the buckets to cache lines before C++17
+		Buckets.reset(AlignedMemory::Allocate<Bucket>(numBuckets));
+		NumBuckets = numBuckets;
+	}
+	Clear();
+}
+
+void TranspositionTable::Clear()
+{
+	for (uint64 i = 0; i < NumBuckets; ++i)
+	{
+		for (Entry& entry : Buckets[i].Entries)
+		{
+			entry = Entry{0, nullptr};
+		}
+	}
+}
+
+BoardState* TranspositionTable::Find(uint64 key) const
+{
+	for (const Entry& entry : GetBucket(key).Entries)
+	{
+		if(entry.Node != nullptr && entry.Key == key)
+		{
+			return entry.Node;
+		}
+	}
+	return nullptr;
+}
+
+void TranspositionTable::Insert(uint64 key, BoardState* node, uint32 generation)
+{
+	Entry* victim = nullptr;
+	uint32 victimValue = 0;
+
+	for (Entry& entry : GetBucket(key).Entries)
+	{
+		if(entry.Node == nullptr || entry.Key == key)
+		{
+			victim = &entry;
+			break;
+		}
+
+		const uint32 value = GetReplacementValue(entry.Node, generation);
+		if(victim == nullptr || value < victimValue)
+		{
+			victim = &entry;
+			victimValue = value;
+		}
+	}
+
+	*victim = Entry{key, node};
+}
+
+void TranspositionTable::Remove(uint64 key, const BoardState* node)
+{
+	for (Entry& entry : GetBucket(key).Entries)
+	{
+		if(entry.Node == node)
+		{
+			entry = Entry{0, nullptr};
+			return;
+		}
+	}
+}
+
+uint32 TranspositionTable::GetReplacementValue(const BoardState* node, uint32 generation)
+{
+	// every search since the node was created halves its worth, the old trees are mostly unreachable
+	const uint32 age = FMath::Min(generation - node->Generation, 31u);
+	return (uint32)node->NumVisited.load(std::memory_order_relaxed) >> age;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "AlignedMemory.h"
+#include "GomokuTypes.h"
+
+class BoardState;
+
+/*
+ *  Fixed size index from position keys to search nodes, used to find transpositions.
+ *  Entries live in buckets of one cache line and a key can only be stored in its own bucket,
+ *  so a full bucket replaces the entry worth the least, few visits and an old generation.
+ *  The table does not own the nodes, a replaced node stays in the tree but is not shared anymore.
+ */
+class TranspositionTable
+{
+
+public:
+
+	TranspositionTable();
+
+	TranspositionTable(const TranspositionTable&) = delete;
+
+	TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+public:
+
+	// rounds down to a power of two number of buckets, forgets every entry
+	void Resize(size_t sizeInBytes);
+
+	void Clear();
+
+	// the full key is stored and compared, only its low bits select the bucket
+	BoardState* Find(uint64 key) const;
+
+	void Insert(uint64 key, BoardState* node, uint32 generation);
+
+	// has to be called before the node is freed
+	void Remove(uint64 key, const BoardState* node);
+
+	size_t GetSizeInBytes() const { return NumBuckets * sizeof(Bucket); }
+
+private:
+
+	struct Entry
+	{
+		uint64 Key;
+
+		BoardState* Node;
+	};
+
+	static constexpr int32 BucketSize = 4;
+
+	struct alignas(64) Bucket
+	{
+		Entry Entries[BucketSize];
+	};
+
+	Bucket& GetBucket(uint64 key) const { return Buckets[key & (NumBuckets - 1)]; }
+
+	static uint32 GetReplacementValue(const BoardState* node, uint32 generation);
+
+private:
+
+	AlignedMemory::Array<Bucket> Buckets;
+
+	uint64 NumBuckets;
+
+};
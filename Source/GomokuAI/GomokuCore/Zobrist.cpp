@@ -0,0 +1,69 @@
+#include "Zobrist.h"
+#include "RandomGenerator.h"
+#include <algorithm>
+
+static constexpr Zobrist::KeyTable GenerateKeys()
+{
+	// fixed seed so hashes are the same in every run and every thread
+	uint64 state = 0x476F6D6F6B75ull;
+	Zobrist::KeyTable keys = {};
+
+	for (int32 stone = 0; stone < 2; ++stone)
+	{
+		for (int32 i = 0; i < MaxBoardCells; ++i)
+		{
+			keys.Stones[stone][i] = SplitMix64(state);
+		}
+	}
+	keys.Turn = SplitMix64(state);
+
+	return keys;
+}
+
+const Zobrist::KeyTable Zobrist::Keys = GenerateKeys();
+
+uint64 Zobrist::Calculate(const BitBoard& board, EStoneType turn)
+{
+	uint64 hash = turn == EStoneType::O ? Keys.Turn : 0;
+
+	board.GetStones(EStoneType::X).ForEachIndex([&hash](int32 index)
+	{
+		hash ^= Keys.Stones[0][index];
+	});
+
+	board.GetStones(EStoneType::O).ForEachIndex([&hash](int32 index)
+	{
+		hash ^= Keys.Stones[1][index];
+	});
+
+	return hash;
+}
+
+
+void Zobrist::CalculateSymmetric(const BitBoard& board, EStoneType turn, uint64 outHashes[NumSymmetries])
+{
+	const BoardGeometry& geometry = BoardGeometry::Get(board.GetWidth());
+	
+	for (int32 symmetry = 0; symmetry < NumSymmetries; ++symmetry)
+	{
+		outHashes[symmetry] = turn == EStoneType::O ? Keys.Turn : 0;
+	}
+
+	for (int32 stone = 0; stone < 2; ++stone)
+	{
+		board.GetStones((EStoneType)(stone + 1)).ForEachIndex([&geometry, outHashes, stone](int32 index)
+		{
+			for (int32 symmetry = 0; symmetry < NumSymmetries; ++symmetry)
+			{
+				outHashes[symmetry] ^= Keys.Stones[stone][geometry.Symmetries[symmetry][index]];
+			}
+		});
+	}
+}
+
+uint64 Zobrist::CalculateCanonical(const BitBoard& board, EStoneType turn)
+{
+	uint64 hashes[NumSymmetries];
+	CalculateSymmetric(board, turn, hashes);
+	return *std::min_element(hashes, hashes + NumSymmetries);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "BitBoard.h"
+
+/*
+ *  Zobrist keys for incremental position hashing. A position hash is the xor of the key of
+ *  every stone on the board, plus the turn key when O is to play, so placing a stone or
+ *  passing the turn updates it with a single xor.
+ */
+class Zobrist
+{
+
+public:
+
+	static uint64 GetStoneKey(int32 index, EStoneType stoneType) { return Keys.Stones[(int32)stoneType - 1][index]; }
+
+	static uint64 GetTurnKey() { return Keys.Turn; }
+
+	static uint64 Calculate(const BitBoard& board, EStoneType turn);
+
+	// the hash of every symmetric copy of board, outHashes[s] is the one of board.Transformed(s)
+	static void CalculateSymmetric(const BitBoard& board, EStoneType turn, uint64 outHashes[NumSymmetries]);
+
+	// the same for all eight symmetric copies of a position
+	static uint64 CalculateCanonical(const BitBoard& board, EStoneType turn);
+
+public:
+
+	struct KeyTable
+	{
+		uint64 Stones[2][MaxBoardCells];
+
+		uint64 Turn;
+	};
+
+private:
+
+	static const KeyTable Keys;
+
+};
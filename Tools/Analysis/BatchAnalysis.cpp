@@ -0,0 +1,427 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "MoveSelection.h"
+#include "PositionText.h"
+#include "Solver.h"
+#include "ThreadPool.h"
+
+/*
+ *  Analyses a stream of positions on all cores, one solver per worker. Input lines are either
+ *  JSON objects with a "board" and optionally an "id" and a "turn", e.g.
+ *
+ *      {"id": "game12-ply30", "board": "....x..o...", "turn": "o"}
+ *
+ *  or the name, turn and board words of Positions.txt. The board is written like in
+ *  Positions.txt, a missing turn is the side with fewer stones. Only a few lines per worker are
+ *  held at a time, and the results are written in input order as JSON lines with the root edges
+ *  of GetRootEdgeEvaluations and the input line number, counted from 1 with the empty lines.
+ *  Moves are cell indexes, x + y * width. A position whose result is decided is marked as solved,
+ *  one decided before the tree search has the decisive move as its only edge.
+ *
+ *  BatchAnalysis [--input file] [--output file] [--workers n] [--iterations n] [--time seconds]
+ *                [--memory megabytes] [--symmetry 0|1] [--max-edges n]
+ */
+
+struct AnalysisOptions
+{
+	std::string InputPath;
+
+	std::string OutputPath;
+
+	int32 NumWorkers = ThreadPool::GetDefaultNumThreads();
+
+	int32 Iterations = 5000;
+
+	float Time = 0;
+
+	// per worker
+	int32 MemoryMegabytes = 32;
+
+	bool UseSymmetry = true;
+
+	// the most visited edges written per position, 0 for all
+	int32 MaxEdges = 0;
+};
+
+struct AnalysisTask
+{
+	// of the non-empty lines, the order the results are written in
+	int64 Index;
+
+	int64 LineNumber;
+
+	std::string Line;
+};
+
+/*
+ *  Lines read but not written yet. The reader waits while MaxInFlight of them are out,
+ *  so memory stays bounded however long the input is.
+ */
+struct AnalysisQueue
+{
+	std::mutex Mutex;
+
+	std::condition_variable TaskAdded;
+
+	std::condition_variable TaskWritten;
+
+	std::deque<AnalysisTask> Tasks;
+
+	// finished lines waiting for an earlier one, by index
+	std::map<int64, std::string> Results;
+
+	int64 NumRead = 0;
+
+	int64 NumWritten = 0;
+
+	int64 MaxInFlight = 0;
+
+	bool IsInputDone = false;
+};
+
+static AnalysisOptions Options;
+
+// the string value of key in a flat JSON object, false when it is not there
+static bool FindJsonString(const std::string& json, const char* key, std::string& outValue)
+{
+	const std::string quotedKey = std::string("\"") + key + "\"";
+	size_t position = json.find(quotedKey);
+	if(position == std::string::npos)
+	{
+		return false;
+	}
+
+	position = json.find(':', position + quotedKey.size());
+	position = position == std::string::npos ? position : json.find('"', position);
+	if(position == std::string::npos)
+	{
+		return false;
+	}
+
+	// a backslash keeps the next character, so an escaped quote does not end the value
+	outValue.clear();
+	for (size_t i = position + 1; i < json.size(); ++i)
+	{
+		if(json[i] == '"')
+		{
+			return true;
+		}
+		if(json[i] == '\\' && i + 1 < json.size())
+		{
+			++i;
+		}
+		outValue += json[i];
+	}
+	return false;
+}
+
+// text inside a JSON string
+static std::string EscapeJson(const std::string& text)
+{
+	std::string escaped;
+	for (char character : text)
+	{
+		if(character == '"' || character == '\\')
+		{
+			escaped += '\\';
+			escaped += character;
+		}
+		else if((unsigned char)character < 0x20)
+		{
+			char code[8];
+			std::snprintf(code, sizeof(code), "\\u%04x", character);
+			escaped += code;
+		}
+		else
+		{
+			escaped += character;
+		}
+	}
+	return escaped;
+}
+
+static bool ParsePosition(const std::string& line, std::string& outId, std::vector<EStoneType>& outBoard, EStoneType& outTurn, std::string& outError)
+{
+	std::string boardText;
+	std::string turnText;
+
+	if(!line.empty() && line[0] == '{')
+	{
+		FindJsonString(line, "id", outId);
+		FindJsonString(line, "turn", turnText);
+		if(!FindJsonString(line, "board", boardText))
+		{
+			outError = "no board";
+			return false;
+		}
+	}
+	else
+	{
+		std::istringstream words(line);
+		words >> outId >> turnText >> boardText;
+	}
+
+	if(!PositionText::ParseBoard(boardText, outBoard))
+	{
+		outError = "the board is not a square of x, o and .";
+		return false;
+	}
+
+	if(turnText.empty())
+	{
+		const int64 numX = std::count(outBoard.begin(), outBoard.end(), EStoneType::X);
+		const int64 numO = std::count(outBoard.begin(), outBoard.end(), EStoneType::O);
+		outTurn = numX > numO ? EStoneType::O : EStoneType::X;
+	}
+	else if(turnText.size() != 1 || !PositionText::ParseStone(turnText[0], outTurn) || outTurn == EStoneType::Empty)
+	{
+		outError = "the turn is not x or o";
+		return false;
+	}
+
+	return true;
+}
+
+static std::string Analyse(Solver& solver, const AnalysisTask& task)
+{
+	std::ostringstream result;
+	result << "{\"line\":" << task.LineNumber;
+
+	std::string id;
+	std::vector<EStoneType> board;
+	EStoneType turn;
+	std::string error;
+	if(!ParsePosition(task.Line, id, board, turn, error))
+	{
+		result << ",\"error\":\"" << EscapeJson(error) << "\"}";
+		return result.str();
+	}
+
+	if(!id.empty())
+	{
+		result << ",\"id\":\"" << EscapeJson(id) << "\"";
+	}
+
+	const std::unordered_map<int32, Evaluation> evaluations = solver.Run(board, turn, -1);
+	const int32 move = MoveSelection::GetMostVisited(evaluations);
+	const SearchStatistics& statistics = solver.GetStatistics();
+
+	// a win found before the tree search is the only move Run returns, the root has no visited edges then
+	const bool isSolved = statistics.IsRootSolved;
+	std::unordered_map<int32, Evaluation> edgeMap = isSolved && statistics.NumIterations == 0 ? evaluations : solver.GetRootEdgeEvaluations();
+	std::vector<std::pair<int32, Evaluation>> edges(edgeMap.begin(), edgeMap.end());
+	std::sort(edges.begin(), edges.end(), [](const std::pair<int32, Evaluation>& a, const std::pair<int32, Evaluation>& b)
+	{
+		return a.second.NumVisited != b.second.NumVisited ? a.second.NumVisited > b.second.NumVisited : a.first < b.first;
+	});
+	if(Options.MaxEdges > 0 && (int32)edges.size() > Options.MaxEdges)
+	{
+		edges.resize(Options.MaxEdges);
+	}
+
+	result << ",\"turn\":\"" << PositionText::FormatStone(turn) << "\",\"move\":" << move << ",\"solved\":" << (isSolved ? "true" : "false")
+		<< ",\"iterations\":" << statistics.NumIterations << ",\"seconds\":" << statistics.Seconds << ",\"edges\":[";
+	for (int32 i = 0; i < (int32)edges.size(); ++i)
+	{
+		const Evaluation& evaluation = edges[i].second;
+		result << (i == 0 ? "" : ",") << "{\"move\":" << edges[i].first << ",\"visits\":" << evaluation.NumVisited
+			<< ",\"score\":" << (evaluation.NumVisited > 0 ? evaluation.SumScore / evaluation.NumVisited : 0) << "}";
+	}
+	result << "]}";
+	return result.str();
+}
+
+static void WorkerLoop(AnalysisQueue& queue, std::ostream& output, int32 workerIndex)
+{
+	Solver solver(Options.Time, Options.Iterations > 0 ? Options.Iterations : 1 << 30, (uint64)workerIndex + 1);
+	solver.SetMemoryBudget(Options.MemoryMegabytes);
+	solver.SetUseSymmetry(Options.UseSymmetry);
+
+	while(true)
+	{
+		AnalysisTask task;
+		{
+			std::unique_lock<std::mutex> lock(queue.Mutex);
+			queue.TaskAdded.wait(lock, [&queue]() { return !queue.Tasks.empty() || queue.IsInputDone; });
+			if(queue.Tasks.empty())
+			{
+				return;
+			}
+
+			task = std::move(queue.Tasks.front());
+			queue.Tasks.pop_front();
+		}
+
+		std::string result = Analyse(solver, task);
+
+		// whoever finishes the oldest line writes it and every later one which is already done
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		queue.Results.emplace(task.Index, std::move(result));
+
+		bool isWritten = false;
+		while(!queue.Results.empty() && queue.Results.begin()->first == queue.NumWritten)
+		{
+			output << queue.Results.begin()->second << '\n';
+			queue.Results.erase(queue.Results.begin());
+			queue.NumWritten++;
+			isWritten = true;
+		}
+
+		if(isWritten)
+		{
+			output.flush();
+			queue.TaskWritten.notify_one();
+		}
+	}
+}
+
+static bool ParseArguments(int argc, char** argv)
+{
+	for (int32 i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+		bool isValid = hasValue;
+
+		if(std::strcmp(argv[i], "--input") == 0 && hasValue)
+		{
+			Options.InputPath = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--output") == 0 && hasValue)
+		{
+			Options.OutputPath = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--workers") == 0 && hasValue)
+		{
+			Options.NumWorkers = std::atoi(argv[++i]);
+			isValid = Options.NumWorkers > 0;
+		}
+		else if(std::strcmp(argv[i], "--iterations") == 0 && hasValue)
+		{
+			Options.Iterations = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--time") == 0 && hasValue)
+		{
+			Options.Time = (float)std::atof(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--memory") == 0 && hasValue)
+		{
+			Options.MemoryMegabytes = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--symmetry") == 0 && hasValue)
+		{
+			Options.UseSymmetry = std::atoi(argv[++i]) != 0;
+		}
+		else if(std::strcmp(argv[i], "--max-edges") == 0 && hasValue)
+		{
+			Options.MaxEdges = std::atoi(argv[++i]);
+		}
+		else
+		{
+			isValid = false;
+		}
+
+		if(!isValid)
+		{
+			std::fprintf(stderr, "usage: %s [--input file] [--output file] [--workers n] [--iterations n] [--time seconds] "
+				"[--memory megabytes] [--symmetry 0|1] [--max-edges n]\n", argv[0]);
+			return false;
+		}
+	}
+
+	// a search without any limit would never return
+	if(Options.Iterations <= 0 && Options.Time <= 0)
+	{
+		std::fprintf(stderr, "--iterations or --time has to be a limit\n");
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if(!ParseArguments(argc, argv))
+	{
+		return 2;
+	}
+
+	std::ifstream inputFile;
+	if(!Options.InputPath.empty())
+	{
+		inputFile.open(Options.InputPath);
+		if(!inputFile)
+		{
+			std::fprintf(stderr, "can not open %s\n", Options.InputPath.c_str());
+			return 1;
+		}
+	}
+	std::istream& input = Options.InputPath.empty() ? std::cin : inputFile;
+
+	std::ofstream outputFile;
+	if(!Options.OutputPath.empty())
+	{
+		outputFile.open(Options.OutputPath);
+		if(!outputFile)
+		{
+			std::fprintf(stderr, "can not open %s\n", Options.OutputPath.c_str());
+			return 1;
+		}
+	}
+	std::ostream& output = Options.OutputPath.empty() ? std::cout : outputFile;
+
+	const auto start = std::chrono::steady_clock::now();
+	AnalysisQueue queue;
+	queue.MaxInFlight = 4 * Options.NumWorkers;
+
+	// the calling thread only reads, every worker has a pool thread
+	ThreadPool pool(Options.NumWorkers);
+	for (int32 i = 0; i < Options.NumWorkers; ++i)
+	{
+		pool.Submit([&queue, &output, i]()
+		{
+			WorkerLoop(queue, output, i);
+		});
+	}
+
+	std::string line;
+	int64 lineNumber = 0;
+	while(std::getline(input, line))
+	{
+		lineNumber++;
+		line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+		if(line.empty())
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(queue.Mutex);
+		queue.TaskWritten.wait(lock, [&queue]() { return queue.NumRead - queue.NumWritten < queue.MaxInFlight; });
+		queue.Tasks.push_back(AnalysisTask{queue.NumRead++, lineNumber, std::move(line)});
+		queue.TaskAdded.notify_one();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		queue.IsInputDone = true;
+	}
+	queue.TaskAdded.notify_all();
+	pool.Wait();
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::fprintf(stderr, "positions %lld seconds %.3f positions/sec %.2f workers %d\n",
+		(long long)queue.NumWritten, seconds, seconds > 0 ? queue.NumWritten / seconds : 0, Options.NumWorkers);
+
+	return 0;
+}
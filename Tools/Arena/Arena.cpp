@@ -0,0 +1,425 @@
+#include <time.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BoardState.h"
+#include "MatchStatistics.h"
+#include "MoveSelection.h"
+#include "RandomGenerator.h"
+#include "Solver.h"
+#include "ThreadPool.h"
+
+/*
+ *  Self-play between two engine configurations, A and B, on all cores. Each game has a solver
+ *  per side which keeps its tree from move to move. Games come in pairs on the same random
+ *  opening with the colours swapped, and the match stops early once the SPRT decides.
+ *
+ *  Arena --engine-a options --engine-b options [--games n] [--concurrency n] [--opening-plies n]
+ *        [--opening-radius n] [--width n] [--seed n] [--records file] [--elo0 elo] [--elo1 elo]
+ *        [--alpha p] [--beta p] [--report-interval games]
+ *
+ *  Engine options are a comma separated list of iterations=n (0 for no limit), time=seconds
+ *  (0 for no limit), memory=megabytes and symmetry=0|1, e.g. iterations=0,time=0.1
+ */
+
+struct EngineOptions
+{
+	int32 Iterations = 2000;
+
+	float Time = 0;
+
+	int32 MemoryMegabytes = 64;
+
+	bool UseSymmetry = true;
+};
+
+struct ArenaOptions
+{
+	EngineOptions Engines[2];
+
+	int32 NumGames = 1000;
+
+	int32 Concurrency = ThreadPool::GetDefaultNumThreads();
+
+	// stones placed at random around the centre before the engines take over, the first one on the centre.
+	// They fill at most half of the square of OpeningRadius around it, and none of them completes five
+	int32 OpeningPlies = 4;
+
+	int32 OpeningRadius = 3;
+
+	int32 Width = 15;
+
+	uint64 Seed = 1;
+
+	std::string RecordsPath;
+
+	float Elo0 = 0;
+
+	float Elo1 = 10;
+
+	float Alpha = 0.05f;
+
+	float Beta = 0.05f;
+
+	int32 ReportInterval = 20;
+};
+
+static const char* EngineNames[2] = {"A", "B"};
+
+struct GameResult
+{
+	std::vector<int32> Moves;
+
+	// engine playing X, 0 for A
+	int32 EngineX = 0;
+
+	// 0 for A, 1 for B, -1 for a draw
+	int32 Winner = -1;
+
+	const char* Reason = "full";
+
+	double CpuSeconds[2] = {0, 0};
+
+	int32 NumMoves[2] = {0, 0};
+};
+
+static ArenaOptions Options;
+
+static double GetThreadCpuSeconds()
+{
+	timespec time;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+static std::vector<int32> MakeOpening(int32 pairIndex)
+{
+	RandomGenerator random(Options.Seed * 0x9E3779B97F4A7C15ull + pairIndex);
+	const int32 width = Options.Width;
+	const int32 centre = width / 2;
+	const int32 side = 2 * Options.OpeningRadius + 1;
+
+	std::vector<int32> opening;
+	BitBoard board(width);
+	EStoneType turn = EStoneType::X;
+	for (int32 ply = 0; ply < Options.OpeningPlies; ++ply)
+	{
+		int32 move = BitBoard::FlattenIndex(centre, centre, width);
+		while(!board.IsEmpty(move) || BoardState::FindSequence(board, move, turn, 5))
+		{
+			const int32 x = centre - Options.OpeningRadius + random.NextInt(side);
+			const int32 y = centre - Options.OpeningRadius + random.NextInt(side);
+			move = BitBoard::FlattenIndex(x, y, width);
+		}
+
+		board.Set(move, turn);
+		opening.push_back(move);
+		turn = Solver::ChangeTurn(turn);
+	}
+	return opening;
+}
+
+static void PlayGame(int32 gameIndex, GameResult& outResult)
+{
+	// both games of a pair start from the same opening, A plays X in the first and O in the second
+	outResult.Moves = MakeOpening(gameIndex / 2);
+	outResult.EngineX = gameIndex % 2;
+
+	std::unique_ptr<Solver> solvers[2];
+	for (int32 engine = 0; engine < 2; ++engine)
+	{
+		const EngineOptions& options = Options.Engines[engine];
+		solvers[engine].reset(new Solver(options.Time, options.Iterations > 0 ? options.Iterations : 1 << 30, Options.Seed + 2 * gameIndex + engine));
+		solvers[engine]->SetMemoryBudget(options.MemoryMegabytes);
+		solvers[engine]->SetUseSymmetry(options.UseSymmetry);
+	}
+
+	const int32 numCells = Options.Width * Options.Width;
+	std::vector<EStoneType> board(numCells, EStoneType::Empty);
+	EStoneType turn = EStoneType::X;
+	for (const int32 move : outResult.Moves)
+	{
+		board[move] = turn;
+		turn = Solver::ChangeTurn(turn);
+	}
+
+	while((int32)outResult.Moves.size() < numCells)
+	{
+		const int32 engine = turn == EStoneType::X ? outResult.EngineX : 1 - outResult.EngineX;
+
+		const double start = GetThreadCpuSeconds();
+		const int32 move = MoveSelection::GetMostVisited(solvers[engine]->Run(board, turn, outResult.Moves.back()));
+		outResult.CpuSeconds[engine] += GetThreadCpuSeconds() - start;
+		outResult.NumMoves[engine]++;
+
+		if(move < 0 || move >= numCells || board[move] != EStoneType::Empty)
+		{
+			outResult.Winner = 1 - engine;
+			outResult.Reason = "illegal";
+			return;
+		}
+
+		board[move] = turn;
+		outResult.Moves.push_back(move);
+
+		if(BoardState::FindSequence(BitBoard(board), move, turn, 5))
+		{
+			outResult.Winner = engine;
+			outResult.Reason = "five";
+			return;
+		}
+
+		turn = Solver::ChangeTurn(turn);
+	}
+}
+
+static void WriteRecord(FILE* records, int32 gameIndex, const GameResult& result)
+{
+	std::fprintf(records, "{\"game\":%d,\"x\":\"%s\",\"o\":\"%s\",\"opening_plies\":%d,\"moves\":[",
+		gameIndex, EngineNames[result.EngineX], EngineNames[1 - result.EngineX], Options.OpeningPlies);
+	for (int32 i = 0; i < (int32)result.Moves.size(); ++i)
+	{
+		std::fprintf(records, i == 0 ? "%d" : ",%d", result.Moves[i]);
+	}
+	std::fprintf(records, "],\"winner\":\"%s\",\"reason\":\"%s\",\"cpu_seconds\":[%.4f,%.4f],\"engine_moves\":[%d,%d]}\n",
+		result.Winner == -1 ? "draw" : EngineNames[result.Winner], result.Reason,
+		result.CpuSeconds[0], result.CpuSeconds[1], result.NumMoves[0], result.NumMoves[1]);
+}
+
+static void PrintReport(const MatchStatistics& statistics, const double cpuSeconds[2], const int32 numMoves[2])
+{
+	std::printf("games %d  A-B +%d =%d -%d  score %.1f%%  elo %.1f +- %.1f  llr %.2f [%.2f, %.2f]  cpu/move A %.4fs B %.4fs\n",
+		statistics.GetNumGames(), statistics.GetNumWins(), statistics.GetNumDraws(), statistics.GetNumLosses(),
+		statistics.GetScore() * 100, statistics.GetElo(), statistics.GetEloMargin(),
+		statistics.GetLlr(), statistics.GetLowerBound(), statistics.GetUpperBound(),
+		numMoves[0] > 0 ? cpuSeconds[0] / numMoves[0] : 0, numMoves[1] > 0 ? cpuSeconds[1] / numMoves[1] : 0);
+	std::fflush(stdout);
+}
+
+static bool ParseEngine(const std::string& text, EngineOptions& outOptions)
+{
+	std::istringstream options(text);
+	std::string option;
+	while(std::getline(options, option, ','))
+	{
+		const size_t separator = option.find('=');
+		if(separator == std::string::npos)
+		{
+			return false;
+		}
+
+		const std::string key = option.substr(0, separator);
+		const char* value = option.c_str() + separator + 1;
+
+		if(key == "iterations")
+		{
+			outOptions.Iterations = std::atoi(value);
+		}
+		else if(key == "time")
+		{
+			outOptions.Time = (float)std::atof(value);
+		}
+		else if(key == "memory")
+		{
+			outOptions.MemoryMegabytes = std::atoi(value);
+		}
+		else if(key == "symmetry")
+		{
+			outOptions.UseSymmetry = std::atoi(value) != 0;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// a search without any limit would never return
+	return outOptions.Iterations > 0 || outOptions.Time > 0;
+}
+
+static bool ParseArguments(int argc, char** argv)
+{
+	for (int32 i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+		bool isValid = hasValue;
+
+		if(std::strcmp(argv[i], "--engine-a") == 0 && hasValue)
+		{
+			isValid = ParseEngine(argv[++i], Options.Engines[0]);
+		}
+		else if(std::strcmp(argv[i], "--engine-b") == 0 && hasValue)
+		{
+			isValid = ParseEngine(argv[++i], Options.Engines[1]);
+		}
+		else if(std::strcmp(argv[i], "--games") == 0 && hasValue)
+		{
+			Options.NumGames = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--concurrency") == 0 && hasValue)
+		{
+			Options.Concurrency = std::atoi(argv[++i]);
+			isValid = Options.Concurrency > 0;
+		}
+		else if(std::strcmp(argv[i], "--opening-plies") == 0 && hasValue)
+		{
+			Options.OpeningPlies = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--opening-radius") == 0 && hasValue)
+		{
+			Options.OpeningRadius = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--width") == 0 && hasValue)
+		{
+			Options.Width = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--seed") == 0 && hasValue)
+		{
+			Options.Seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if(std::strcmp(argv[i], "--records") == 0 && hasValue)
+		{
+			Options.RecordsPath = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--elo0") == 0 && hasValue)
+		{
+			Options.Elo0 = (float)std::atof(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--elo1") == 0 && hasValue)
+		{
+			Options.Elo1 = (float)std::atof(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--alpha") == 0 && hasValue)
+		{
+			Options.Alpha = (float)std::atof(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--beta") == 0 && hasValue)
+		{
+			Options.Beta = (float)std::atof(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--report-interval") == 0 && hasValue)
+		{
+			Options.ReportInterval = std::atoi(argv[++i]);
+			isValid = Options.ReportInterval > 0;
+		}
+		else
+		{
+			isValid = false;
+		}
+
+		if(!isValid)
+		{
+			std::fprintf(stderr, "usage: %s --engine-a options --engine-b options [--games n] [--concurrency n] [--opening-plies n] "
+				"[--opening-radius n] [--width n] [--seed n] [--records file] [--elo0 elo] [--elo1 elo] [--alpha p] [--beta p] [--report-interval games]\n"
+				"engine options: iterations=n,time=seconds,memory=megabytes,symmetry=0|1\n", argv[0]);
+			return false;
+		}
+	}
+
+	// the options depend on each other, so they are checked in any order they came in
+	const int32 side = 2 * Options.OpeningRadius + 1;
+	if(Options.OpeningRadius < 0 || Options.Width < side || Options.Width > MaxBoardWidth)
+	{
+		std::fprintf(stderr, "--width has to fit the opening square of side %d and be at most %d\n", side, MaxBoardWidth);
+		return false;
+	}
+
+	// a fuller square would leave the random placement little room to avoid fives
+	if(Options.OpeningPlies <= 0 || Options.OpeningPlies > side * side / 2)
+	{
+		std::fprintf(stderr, "--opening-plies has to be between 1 and %d for --opening-radius %d\n", side * side / 2, Options.OpeningRadius);
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if(!ParseArguments(argc, argv))
+	{
+		return 2;
+	}
+
+	FILE* records = nullptr;
+	if(!Options.RecordsPath.empty())
+	{
+		records = std::fopen(Options.RecordsPath.c_str(), "w");
+		if(records == nullptr)
+		{
+			std::fprintf(stderr, "can not open %s\n", Options.RecordsPath.c_str());
+			return 1;
+		}
+	}
+
+	MatchStatistics statistics(Options.Elo0, Options.Elo1, Options.Alpha, Options.Beta);
+	double cpuSeconds[2] = {0, 0};
+	int32 numMoves[2] = {0, 0};
+	std::mutex resultMutex;
+	std::atomic<int32> nextGame(0);
+	std::atomic<bool> isDecided(false);
+
+	// every thread plays one game after the other, a solver only ever uses the thread playing its game
+	ThreadPool pool(Options.Concurrency - 1);
+	pool.RunShared(Options.Concurrency - 1, [&](int32)
+	{
+		while(!isDecided.load())
+		{
+			const int32 gameIndex = nextGame.fetch_add(1);
+			if(gameIndex >= Options.NumGames)
+			{
+				break;
+			}
+
+			GameResult result;
+			PlayGame(gameIndex, result);
+
+			std::lock_guard<std::mutex> lock(resultMutex);
+
+			statistics.AddResult(result.Winner == -1 ? 0.5f : result.Winner == 0 ? 1.0f : 0.0f);
+			for (int32 engine = 0; engine < 2; ++engine)
+			{
+				cpuSeconds[engine] += result.CpuSeconds[engine];
+				numMoves[engine] += result.NumMoves[engine];
+			}
+
+			if(records != nullptr)
+			{
+				WriteRecord(records, gameIndex, result);
+			}
+
+			if(statistics.GetNumGames() % Options.ReportInterval == 0)
+			{
+				PrintReport(statistics, cpuSeconds, numMoves);
+			}
+
+			// games already running are still counted, stopping only keeps new ones from starting
+			if(statistics.GetResult() != ESprtResult::Continue)
+			{
+				isDecided = true;
+			}
+		}
+	});
+
+	if(records != nullptr)
+	{
+		std::fclose(records);
+	}
+
+	if(statistics.GetNumGames() % Options.ReportInterval != 0)
+	{
+		PrintReport(statistics, cpuSeconds, numMoves);
+	}
+
+	const ESprtResult result = statistics.GetResult();
+	std::printf("sprt elo0 %.1f elo1 %.1f alpha %.3f beta %.3f: %s\n", Options.Elo0, Options.Elo1, Options.Alpha, Options.Beta,
+		result == ESprtResult::AcceptH1 ? "H1 accepted, A is stronger by elo1" :
+		result == ESprtResult::AcceptH0 ? "H0 accepted, A is not stronger by elo1" : "inconclusive");
+
+	return 0;
+}
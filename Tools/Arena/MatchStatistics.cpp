@@ -0,0 +1,111 @@
+#include "MatchStatistics.h"
+#include <cmath>
+
+MatchStatistics::MatchStatistics(float elo0, float elo1, float alpha, float beta)
+{
+	Elo0 = elo0;
+	Elo1 = elo1;
+	Alpha = alpha;
+	Beta = beta;
+	NumWins = 0;
+	NumDraws = 0;
+	NumLosses = 0;
+}
+
+void MatchStatistics::AddResult(float score)
+{
+	if(score > 0.75f)
+	{
+		NumWins++;
+	}
+	else if(score < 0.25f)
+	{
+		NumLosses++;
+	}
+	else
+	{
+		NumDraws++;
+	}
+}
+
+float MatchStatistics::GetScore() const
+{
+	const int32 numGames = GetNumGames();
+	return numGames > 0 ? (NumWins + 0.5f * NumDraws) / numGames : 0.5f;
+}
+
+float MatchStatistics::GetScoreVariance() const
+{
+	const int32 numGames = GetNumGames();
+	if(numGames == 0)
+	{
+		return 0;
+	}
+
+	const float score = GetScore();
+	return (NumWins * (1 - score) * (1 - score) + NumDraws * (0.5f - score) * (0.5f - score) + NumLosses * score * score) / numGames;
+}
+
+float MatchStatistics::GetElo() const
+{
+	return ScoreToElo(GetScore());
+}
+
+float MatchStatistics::GetEloMargin() const
+{
+	const int32 numGames = GetNumGames();
+	if(numGames == 0)
+	{
+		return 0;
+	}
+
+	const float score = GetScore();
+	const float deviation = std::sqrt(GetScoreVariance() / numGames);
+	return (ScoreToElo(score + 1.96f * deviation) - ScoreToElo(score - 1.96f * deviation)) / 2;
+}
+
+float MatchStatistics::GetLlr() const
+{
+	// results without spread, e.g. only wins, would have no variance and never end the test
+	const float variance = std::fmax(GetScoreVariance(), MinScoreVariance);
+
+	const float score0 = EloToScore(Elo0);
+	const float score1 = EloToScore(Elo1);
+	return GetNumGames() * (score1 - score0) * (2 * GetScore() - score0 - score1) / (2 * variance);
+}
+
+float MatchStatistics::GetLowerBound() const
+{
+	return std::log(Beta / (1 - Alpha));
+}
+
+float MatchStatistics::GetUpperBound() const
+{
+	return std::log((1 - Beta) / Alpha);
+}
+
+ESprtResult MatchStatistics::GetResult() const
+{
+	const float llr = GetLlr();
+	if(llr >= GetUpperBound())
+	{
+		return ESprtResult::AcceptH1;
+	}
+	if(llr <= GetLowerBound())
+	{
+		return ESprtResult::AcceptH0;
+	}
+	return ESprtResult::Continue;
+}
+
+float MatchStatistics::ScoreToElo(float score)
+{
+	// a perfect score has no finite Elo, it is shown as the one of 99.9%
+	const float clamped = score < 0.001f ? 0.001f : score > 0.999f ? 0.999f : score;
+	return -400 * std::log10(1 / clamped - 1);
+}
+
+float MatchStatistics::EloToScore(float elo)
+{
+	return 1 / (1 + std::pow(10.0f, -elo / 400));
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "GomokuTypes.h"
+
+enum class ESprtResult : uint8
+{
+	Continue = 0,
+	AcceptH0 = 1,
+	AcceptH1 = 2
+};
+
+/*
+ *  Results of a match from the first engine's side, with its Elo estimate and a sequential
+ *  probability ratio test of H1: the difference is Elo1 against H0: the difference is Elo0.
+ *  The log likelihood ratio uses the normal approximation of the game scores, so it is only
+ *  meaningful after a few dozen games.
+ */
+class MatchStatistics
+{
+
+public:
+
+	// alpha and beta are the chances of accepting H1 when H0 holds and the other way round
+	MatchStatistics(float elo0, float elo1, float alpha, float beta);
+
+public:
+
+	// 1 for a win of the first engine, 0.5 for a draw and 0 for a loss
+	void AddResult(float score);
+
+	int32 GetNumGames() const { return NumWins + NumDraws + NumLosses; }
+
+	int32 GetNumWins() const { return NumWins; }
+
+	int32 GetNumDraws() const { return NumDraws; }
+
+	int32 GetNumLosses() const { return NumLosses; }
+
+	float GetScore() const;
+
+	float GetElo() const;
+
+	// half the width of the 95% confidence interval of GetElo
+	float GetEloMargin() const;
+
+	float GetLlr() const;
+
+	float GetLowerBound() const;
+
+	float GetUpperBound() const;
+
+	ESprtResult GetResult() const;
+
+private:
+
+	float GetScoreVariance() const;
+
+	static float ScoreToElo(float score);
+
+	static float EloToScore(float elo);
+
+	// the variance GetLlr uses at least, the one of a score which is 0 or 1 in one game out of 50
+	static constexpr float MinScoreVariance = 0.02f;
+
+private:
+
+	float Elo0;
+
+	float Elo1;
+
+	float Alpha;
+
+	float Beta;
+
+	int32 NumWins;
+
+	int32 NumDraws;
+
+	int32 NumLosses;
+
+};
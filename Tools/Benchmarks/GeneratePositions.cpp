@@ -0,0 +1,242 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "BoardState.h"
+#include "MoveSelection.h"
+#include "PositionSet.h"
+#include "PositionText.h"
+#include "RandomGenerator.h"
+#include "Solver.h"
+
+/*
+ *  Writes the midgame and crowded positions of a position file to stdout, in its format.
+ *  Midgames are games of engine self-play from the openings of the file, cut at the first quiet
+ *  position from MidgamePly on. Crowded positions continue a midgame with random moves which keep
+ *  it quiet, until CrowdedStones stones are on the board. See PositionSet::IsQuiet.
+ *  Games which end or stay loud for too long are replayed with the next seed. The searches before
+ *  the tree search have time limits, so a run may not repeat the games of the last one.
+ *
+ *  GeneratePositions [--positions file] [--seed n] [--iterations n]
+ */
+
+struct GeneratorOptions
+{
+	std::string PositionsPath = GOMOKU_BENCHMARK_POSITIONS;
+
+	uint64 Seed = 1;
+
+	int32 Iterations = 2000;
+
+	int32 MidgamePly = 20;
+
+	int32 MaxMidgamePly = 48;
+
+	int32 CrowdedStones = 90;
+
+	int32 MaxAttempts = 100;
+};
+
+static GeneratorOptions Options;
+
+static bool IsQuiet(const std::vector<EStoneType>& board, EStoneType turn)
+{
+	std::string reason;
+	return PositionSet::IsQuiet(board, turn, reason);
+}
+
+// plays the engine against itself from the opening, false when the game ends before a quiet position
+static bool PlayMidgame(const BenchmarkPosition& opening, uint64 seed, std::vector<EStoneType>& outBoard, EStoneType& outTurn)
+{
+	Solver solver(0, Options.Iterations, seed);
+	outBoard = opening.Board;
+	outTurn = opening.Turn;
+
+	int32 numStones = 0;
+	for (EStoneType cell : outBoard)
+	{
+		numStones += cell != EStoneType::Empty ? 1 : 0;
+	}
+
+	int32 lastMove = -1;
+	for (; numStones < Options.MaxMidgamePly; ++numStones)
+	{
+		if(numStones >= Options.MidgamePly && IsQuiet(outBoard, outTurn))
+		{
+			return true;
+		}
+
+		// the solver keeps its tree for the reply, both sides play from it
+		const int32 move = MoveSelection::GetMostVisited(solver.Run(outBoard, outTurn, lastMove));
+		if(move < 0 || outBoard[move] != EStoneType::Empty)
+		{
+			return false;
+		}
+
+		outBoard[move] = outTurn;
+		if(BoardState::FindSequence(BitBoard(outBoard), move, outTurn, 5))
+		{
+			return false;
+		}
+
+		outTurn = Solver::ChangeTurn(outTurn);
+		lastMove = move;
+	}
+	return false;
+}
+
+// random moves next to the stones, each one has to leave the position quiet. Moves which leave
+// it quiet for both sides are taken first, so no threats pile up which later moves could not answer
+static bool FillCrowded(uint64 seed, std::vector<EStoneType>& board, EStoneType& turn)
+{
+	RandomGenerator random(seed);
+
+	int32 numStones = 0;
+	for (EStoneType cell : board)
+	{
+		numStones += cell != EStoneType::Empty ? 1 : 0;
+	}
+
+	for (; numStones < Options.CrowdedStones; ++numStones)
+	{
+		MoveList candidates = MoveList::FromMask(BitBoard(board).GetNeighbourhood());
+		random.Shuffle(candidates);
+
+		int32 move = -1;
+		int32 fallbackMove = -1;
+
+		for (int32 i = 0; i < candidates.Num && move == -1; ++i)
+		{
+			board[candidates.Moves[i]] = turn;
+			if(IsQuiet(board, Solver::ChangeTurn(turn)))
+			{
+				if(IsQuiet(board, turn))
+				{
+					move = candidates.Moves[i];
+				}
+				else if(fallbackMove == -1)
+				{
+					fallbackMove = candidates.Moves[i];
+				}
+			}
+			board[candidates.Moves[i]] = EStoneType::Empty;
+		}
+
+		move = move != -1 ? move : fallbackMove;
+		if(move == -1)
+		{
+			return false;
+		}
+
+		board[move] = turn;
+		turn = Solver::ChangeTurn(turn);
+	}
+	return true;
+}
+
+static void PrintPosition(const std::string& name, const std::vector<EStoneType>& board, EStoneType turn)
+{
+	std::printf("%s %c %s\n", name.c_str(), PositionText::FormatStone(turn), PositionText::FormatBoard(board).c_str());
+}
+
+static bool ParseArguments(int argc, char** argv)
+{
+	for (int32 i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(std::strcmp(argv[i], "--positions") == 0 && hasValue)
+		{
+			Options.PositionsPath = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--seed") == 0 && hasValue)
+		{
+			Options.Seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if(std::strcmp(argv[i], "--iterations") == 0 && hasValue)
+		{
+			Options.Iterations = std::atoi(argv[++i]);
+		}
+		else
+		{
+			std::fprintf(stderr, "usage: %s [--positions file] [--seed n] [--iterations n]\n", argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if(!ParseArguments(argc, argv))
+	{
+		return 2;
+	}
+
+	PositionSet positions;
+	std::string error;
+	if(!positions.Load(Options.PositionsPath, error))
+	{
+		std::fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	std::vector<const BenchmarkPosition*> openings;
+	for (const BenchmarkPosition& position : positions.GetPositions())
+	{
+		if(position.Category == "opening")
+		{
+			openings.push_back(&position);
+		}
+	}
+
+	std::vector<std::vector<EStoneType>> boards[2];
+	std::vector<EStoneType> turns[2];
+	uint64 seed = Options.Seed;
+
+	for (const BenchmarkPosition* opening : openings)
+	{
+		std::vector<EStoneType> midgame;
+		EStoneType midgameTurn;
+		std::vector<EStoneType> crowded;
+		EStoneType crowdedTurn;
+		int32 attempt = 0;
+
+		// a midgame whose threats can not all be answered gives no crowded position, so it is played again
+		do
+		{
+			if(attempt++ == Options.MaxAttempts)
+			{
+				std::fprintf(stderr, "no quiet positions from %s\n", opening->Name.c_str());
+				return 1;
+			}
+
+			if(!PlayMidgame(*opening, seed++, midgame, midgameTurn))
+			{
+				continue;
+			}
+			crowded = midgame;
+			crowdedTurn = midgameTurn;
+		}
+		while(crowded.empty() || !FillCrowded(seed++, crowded, crowdedTurn));
+
+		boards[0].push_back(midgame);
+		turns[0].push_back(midgameTurn);
+		boards[1].push_back(crowded);
+		turns[1].push_back(crowdedTurn);
+	}
+
+	const char* categories[2] = {"midgame", "crowded"};
+	for (int32 category = 0; category < 2; ++category)
+	{
+		for (size_t i = 0; i < boards[category].size(); ++i)
+		{
+			char name[32];
+			std::snprintf(name, sizeof(name), "%s-%02d", categories[category], (int32)i + 1);
+			PrintPosition(name, boards[category][i], turns[category][i]);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,342 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "BoardState.h"
+#include "LinePattern.h"
+#include "PositionSet.h"
+#include "RandomGenerator.h"
+
+/*
+ *  Microbenchmarks of the board kernels the search spends its time in, run over the positions
+ *  of Positions.txt grouped by category. Each kernel is repeated until it ran for the minimum
+ *  time and is reported in nanoseconds and heap allocations per call.
+ *
+ *  KernelBenchmark [--positions file] [--filter text] [--min-time seconds]
+ */
+
+static int64 NumAllocations = 0;
+
+void* operator new(size_t size)
+{
+	NumAllocations++;
+	if(void* memory = std::malloc(size != 0 ? size : 1))
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+// results are folded into it so the compiler can not drop the calls
+static volatile uint64 Sink = 0;
+
+struct BenchmarkOptions
+{
+	std::string PositionsPath = GOMOKU_BENCHMARK_POSITIONS;
+
+	std::string Filter;
+
+	double MinTime = 0.2;
+};
+
+static BenchmarkOptions Options;
+
+// calls function, which does numOps kernel calls, until it ran for Options.MinTime
+template<typename FunctionType>
+static void RunBenchmark(const std::string& name, int64 numOps, FunctionType function)
+{
+	if(!Options.Filter.empty() && name.find(Options.Filter) == std::string::npos)
+	{
+		return;
+	}
+
+	// one untimed call, so first touch costs and lazily built tables are not measured
+	function();
+
+	int64 numCalls = 1;
+	while(true)
+	{
+		const int64 startAllocations = NumAllocations;
+		const auto start = std::chrono::steady_clock::now();
+
+		for (int64 i = 0; i < numCalls; ++i)
+		{
+			function();
+		}
+
+		const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		const int64 allocations = NumAllocations - startAllocations;
+
+		if(elapsed >= Options.MinTime)
+		{
+			const double totalOps = (double)numCalls * numOps;
+			std::printf("%-48s %12.1f ns/op %10.2f allocs/op\n", name.c_str(), elapsed * 1e9 / totalOps, allocations / totalOps);
+			return;
+		}
+
+		numCalls *= elapsed > Options.MinTime / 16 ? 2 : 8;
+	}
+}
+
+static const char* GetDirectionName(int32 direction)
+{
+	int32 dx;
+	int32 dy;
+	LinePatterns::GetDirection(direction, dx, dy);
+
+	if(dy == 0)
+	{
+		return "horizontal";
+	}
+	if(dx == 0)
+	{
+		return "vertical";
+	}
+	return dx == dy ? "diagonal" : "antidiagonal";
+}
+
+// numStones X stones in a row up to the centre in direction, the returned cell extends the row by one
+static int32 MakeLineBoard(int32 width, int32 direction, int32 numStones, BitBoard& outBoard)
+{
+	int32 dx;
+	int32 dy;
+	LinePatterns::GetDirection(direction, dx, dy);
+
+	outBoard = BitBoard(width);
+	const int32 centre = width / 2;
+	for (int32 i = 2 - numStones; i < 2; ++i)
+	{
+		outBoard.Set(BitBoard::FlattenIndex(centre + i * dx, centre + i * dy, width), EStoneType::X);
+	}
+	return BitBoard::FlattenIndex(centre + 2 * dx, centre + 2 * dy, width);
+}
+
+static void BenchmarkFindSequence(const std::vector<const BenchmarkPosition*>& positions, const std::string& category)
+{
+	// every empty cell next to the stones, for both players, the way Expand asks
+	std::vector<std::pair<BitBoard, MoveList>> boards;
+	int64 numQueries = 0;
+	for (const BenchmarkPosition* position : positions)
+	{
+		const BitBoard board(position->Board);
+		boards.emplace_back(board, MoveList::FromMask(board.GetNeighbourhood()));
+		numQueries += 2 * boards.back().second.Num;
+	}
+
+	RunBenchmark("FindSequence/" + category, numQueries, [&boards]()
+	{
+		uint64 hits = 0;
+		for (const auto& board : boards)
+		{
+			for (int32 i = 0; i < board.second.Num; ++i)
+			{
+				CellMask blocks;
+				hits += BoardState::FindSequence(board.first, board.second.Moves[i], EStoneType::X, 4, &blocks);
+				hits += BoardState::FindSequence(board.first, board.second.Moves[i], EStoneType::O, 4, &blocks);
+			}
+		}
+		Sink += hits;
+	});
+}
+
+static void BenchmarkLines(int32 width)
+{
+	// a hit returns at its direction, so the later directions cost more
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		BitBoard board;
+		const int32 index = MakeLineBoard(width, direction, 4, board);
+
+		RunBenchmark(std::string("FindSequence/hit/") + GetDirectionName(direction), 1, [&board, index]()
+		{
+			Sink += BoardState::FindSequence(board, index, EStoneType::X, 5);
+		});
+	}
+
+	// a row of three in direction makes four, a miss reads every direction but only this one finds stones
+	for (int32 direction = 0; direction < LinePatterns::NumDirections; ++direction)
+	{
+		BitBoard board;
+		const int32 index = MakeLineBoard(width, direction, 3, board);
+
+		RunBenchmark(std::string("FindSequence/miss/") + GetDirectionName(direction), 1, [&board, index]()
+		{
+			Sink += BoardState::FindSequence(board, index, EStoneType::X, 5);
+		});
+	}
+
+	// stones around the cell but no line through it, every direction is read
+	BitBoard nearBoard(width);
+	const int32 centre = BitBoard::FlattenIndex(width / 2, width / 2, width);
+	nearBoard.Set(centre - 1, EStoneType::X);
+	nearBoard.Set(centre - width, EStoneType::O);
+	nearBoard.Set(centre + width + 1, EStoneType::X);
+	RunBenchmark("FindSequence/miss/near", 1, [&nearBoard, centre]()
+	{
+		Sink += BoardState::FindSequence(nearBoard, centre, EStoneType::X, 5);
+	});
+
+	// no own stone in reach, the neighbourhood test rejects it
+	BitBoard farBoard(width);
+	farBoard.Set(0, EStoneType::X);
+	RunBenchmark("FindSequence/miss/isolated", 1, [&farBoard, centre]()
+	{
+		Sink += BoardState::FindSequence(farBoard, centre, EStoneType::X, 5);
+	});
+}
+
+static void BenchmarkCategory(const std::vector<const BenchmarkPosition*>& positions, const std::string& category)
+{
+	// Expand proves decisive states and Simulate returns at once for proven ones, so it gets its own copies
+	std::vector<std::unique_ptr<BoardState>> states;
+	std::vector<std::unique_ptr<BoardState>> simulatedStates;
+	for (const BenchmarkPosition* position : positions)
+	{
+		states.emplace_back(new BoardState(BitBoard(position->Board), position->Turn));
+		simulatedStates.emplace_back(new BoardState(BitBoard(position->Board), position->Turn));
+	}
+	const int64 numStates = (int64)states.size();
+	RandomGenerator random(1);
+
+	BenchmarkFindSequence(positions, category);
+
+	RunBenchmark("Evaluate/" + category, numStates, [&states]()
+	{
+		float sum = 0;
+		for (const auto& state : states)
+		{
+			sum += state->Evaluate(BoardState::MinScoredLength, BoardState::MaxScoredLength);
+		}
+		Sink += (uint64)sum;
+	});
+
+	RunBenchmark("GenerateExpansionIndexes/" + category, numStates, [&states]()
+	{
+		int32 count = 0;
+		for (const auto& state : states)
+		{
+			count += state->GenerateExpansionIndexes().Count();
+		}
+		Sink += count;
+	});
+
+	RunBenchmark("GenerateShuffledExpansionIndexes/" + category, numStates, [&states, &random]()
+	{
+		int32 first = 0;
+		for (const auto& state : states)
+		{
+			first += state->GenerateShuffledExpansionIndexes(random).Moves[0];
+		}
+		Sink += first;
+	});
+
+	// Expand only sets the leaf fields of the state, so expanding the same states again does the same work
+	RunBenchmark("Expand/" + category, numStates, [&states]()
+	{
+		int32 numActions = 0;
+		for (const auto& state : states)
+		{
+			MoveList actions;
+			state->Expand(actions);
+			numActions += actions.Num;
+		}
+		Sink += numActions;
+	});
+
+	RunBenchmark("Simulate/" + category, numStates, [&simulatedStates, &random]()
+	{
+		float sum = 0;
+		for (const auto& state : simulatedStates)
+		{
+			sum += state->Simulate(random);
+		}
+		Sink += (uint64)sum;
+	});
+
+	RunBenchmark("CalculateHash/" + category, numStates, [&states]()
+	{
+		uint64 hashes = 0;
+		for (const auto& state : states)
+		{
+			state->CalculateHash();
+			hashes ^= state->Hash;
+		}
+		Sink += hashes;
+	});
+}
+
+static bool ParseArguments(int argc, char** argv)
+{
+	for (int32 i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(std::strcmp(argv[i], "--positions") == 0 && hasValue)
+		{
+			Options.PositionsPath = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--filter") == 0 && hasValue)
+		{
+			Options.Filter = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+		{
+			Options.MinTime = std::atof(argv[++i]);
+		}
+		else
+		{
+			std::fprintf(stderr, "usage: %s [--positions file] [--filter text] [--min-time seconds]\n", argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if(!ParseArguments(argc, argv))
+	{
+		return 2;
+	}
+
+	PositionSet positions;
+	std::string error;
+	if(!positions.Load(Options.PositionsPath, error))
+	{
+		std::fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	std::printf("positions %s version %d\n", Options.PositionsPath.c_str(), positions.GetVersion());
+
+	BenchmarkLines(BitBoard(positions.GetPositions()[0].Board).GetWidth());
+
+	for (const std::string& category : positions.GetCategories())
+	{
+		std::vector<const BenchmarkPosition*> inCategory;
+		for (const BenchmarkPosition& position : positions.GetPositions())
+		{
+			if(position.Category == category)
+			{
+				inCategory.push_back(&position);
+			}
+		}
+		BenchmarkCategory(inCategory, category);
+	}
+
+	return 0;
+}
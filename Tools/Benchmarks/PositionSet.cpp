@@ -0,0 +1,130 @@
+#include "PositionSet.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "BoardState.h"
+#include "PositionText.h"
+#include "ThreatMoves.h"
+#include "ThreatSearch.h"
+
+bool PositionSet::Load(const std::string& path, std::string& outError)
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		outError = "can not open " + path;
+		return false;
+	}
+
+	Version = 0;
+	Positions.clear();
+
+	std::string line;
+	int32 lineNumber = 0;
+	while(std::getline(file, line))
+	{
+		lineNumber++;
+		if(line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream words(line);
+		std::string name;
+		std::string turn;
+		std::string board;
+		words >> name >> turn >> board;
+
+		if(name == "version")
+		{
+			Version = std::atoi(turn.c_str());
+			continue;
+		}
+
+		BenchmarkPosition position;
+		position.Name = name;
+		position.Category = name.substr(0, name.find('-'));
+
+		if(turn.size() != 1 || !PositionText::ParseStone(turn[0], position.Turn) || position.Turn == EStoneType::Empty ||
+			!PositionText::ParseBoard(board, position.Board))
+		{
+			outError = path + ":" + std::to_string(lineNumber) + ": expected name, x or o and a board";
+			return false;
+		}
+
+		Positions.push_back(position);
+	}
+
+	if(Version == 0 || Positions.empty())
+	{
+		outError = path + ": no version line or no positions";
+		return false;
+	}
+	return true;
+}
+
+std::vector<std::string> PositionSet::GetCategories() const
+{
+	std::vector<std::string> categories;
+	for (const BenchmarkPosition& position : Positions)
+	{
+		if(std::find(categories.begin(), categories.end(), position.Category) == categories.end())
+		{
+			categories.push_back(position.Category);
+		}
+	}
+	return categories;
+}
+
+bool PositionSet::IsQuiet(const std::vector<EStoneType>& board, EStoneType turn, std::string& outReason)
+{
+	const BitBoard bitBoard(board);
+	const std::string mover(1, PositionText::FormatStone(turn));
+
+	for (EStoneType stoneType : {EStoneType::X, EStoneType::O})
+	{
+		const std::string side(1, PositionText::FormatStone(stoneType));
+
+		bool hasFive = false;
+		bitBoard.GetStones(stoneType).ForEachIndex([&](int32 index)
+		{
+			hasFive |= BoardState::FindSequence(bitBoard, index, stoneType, 5);
+		});
+		if(hasFive)
+		{
+			outReason = side + " has five";
+			return false;
+		}
+
+		if(!ThreatMoves::GetFiveCells(bitBoard, stoneType).IsEmpty())
+		{
+			outReason = side + " has a four";
+			return false;
+		}
+	}
+
+	// the fours BoardState::Expand ends the search at, a run of four with an open end
+	bool makesFour = false;
+	bitBoard.GetNeighbourhood().ForEachIndex([&](int32 index)
+	{
+		CellMask ends;
+		makesFour |= BoardState::FindSequence(bitBoard, index, turn, 4, &ends) && !ends.IsEmpty();
+	});
+	if(makesFour)
+	{
+		outReason = mover + " can make a four";
+		return false;
+	}
+
+	// the budget Solver gives its threat search, without the clock so the result does not depend on the machine
+	ThreatSearch threats(20000, 0);
+	std::vector<int32> line;
+	if(threats.FindWin(bitBoard, turn, line))
+	{
+		outReason = mover + " wins by threats";
+		return false;
+	}
+
+	return true;
+}
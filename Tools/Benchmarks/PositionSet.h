@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "StoneType.h"
+
+struct BenchmarkPosition
+{
+	std::string Name;
+
+	// the part of the name before the dash, e.g. opening
+	std::string Category;
+
+	std::vector<EStoneType> Board;
+
+	EStoneType Turn;
+};
+
+/*
+ *  The fixed positions the benchmarks run on, read from a file like Positions.txt.
+ *  The version in the file is reported with every result, results of different versions are not comparable.
+ */
+class PositionSet
+{
+
+public:
+
+	PositionSet() : Version(0) {}
+
+public:
+
+	// false with outError set when the file can not be read or a line is malformed
+	bool Load(const std::string& path, std::string& outError);
+
+	int32 GetVersion() const { return Version; }
+
+	const std::vector<BenchmarkPosition>& GetPositions() const { return Positions; }
+
+	// in the order of their first position
+	std::vector<std::string> GetCategories() const;
+
+	// neither side has a five or a four, and the side to move can neither make a four nor win by threats
+	// within the budget of Solver's threat search. Solver answers other positions before its tree search,
+	// so they measure nothing of it. outReason says what was found otherwise
+	static bool IsQuiet(const std::vector<EStoneType>& board, EStoneType turn, std::string& outReason);
+
+private:
+
+	int32 Version;
+
+	std::vector<BenchmarkPosition> Positions;
+
+};
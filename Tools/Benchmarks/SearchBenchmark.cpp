@@ -0,0 +1,222 @@
+#include <sys/resource.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "MoveSelection.h"
+#include "PositionSet.h"
+#include "Solver.h"
+#include "ThreadPool.h"
+
+/*
+ *  Throughput of Solver::Run on the positions of Positions.txt, once with a fixed number of
+ *  iterations and once with a fixed time per move, for every thread count asked for.
+ *  Each position is searched twice like in a game: the first search starts a new tree and
+ *  the second answers for the opponent after the chosen move, so it reuses the first tree.
+ *  Every search is one JSON line on stdout, followed by one summary line per budget and thread count.
+ *  Searches whose root was solved before or by the tree search are counted apart in the summary,
+ *  they end after few or no iterations and would distort the throughput.
+ *
+ *  SearchBenchmark [--positions file] [--threads 1,2,4] [--iterations n] [--time seconds]
+ *                  [--memory megabytes] [--symmetry 0|1] [--seed n]
+ */
+
+struct BenchmarkOptions
+{
+	std::string PositionsPath = GOMOKU_BENCHMARK_POSITIONS;
+
+	std::vector<int32> ThreadCounts = {1};
+
+	int32 Iterations = 5000;
+
+	float Time = 1.0f;
+
+	int32 MemoryMegabytes = 64;
+
+	bool UseSymmetry = false;
+
+	uint64 Seed = 1;
+};
+
+static BenchmarkOptions Options;
+
+struct BudgetTotals
+{
+	int64 NumIterations = 0;
+
+	double Seconds = 0;
+
+	int64 NumNodesCreated = 0;
+
+	int32 NumSearches = 0;
+
+	int32 NumSolvedSearches = 0;
+};
+
+static long GetPeakMemoryKilobytes()
+{
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+static void PrintSearch(const std::string& budget, int32 numThreads, int32 version, const BenchmarkPosition& position,
+	const char* search, int32 move, const SearchStatistics& statistics)
+{
+	const double iterationsPerSecond = statistics.Seconds > 0 ? statistics.NumIterations / statistics.Seconds : 0;
+
+	std::printf("{\"positions_version\":%d,\"budget\":\"%s\",\"threads\":%d,\"position\":\"%s\",\"search\":\"%s\","
+		"\"move\":%d,\"iterations\":%d,\"seconds\":%.6f,\"iterations_per_second\":%.1f,\"nodes_created\":%d,"
+		"\"transpositions\":%d,\"nodes_kept\":%d,\"root_visits_kept\":%d,\"reserved_bytes\":%zu,\"solved\":%s}\n",
+		version, budget.c_str(), numThreads, position.Name.c_str(), search,
+		move, statistics.NumIterations, statistics.Seconds, iterationsPerSecond, statistics.NumNodesCreated,
+		statistics.NumTranspositions, statistics.NumNodesKept, statistics.NumRootVisitsKept, statistics.ReservedBytes,
+		statistics.IsRootSolved ? "true" : "false");
+}
+
+static void AddSearch(BudgetTotals& totals, const SearchStatistics& statistics)
+{
+	if(statistics.IsRootSolved)
+	{
+		totals.NumSolvedSearches++;
+		return;
+	}
+
+	totals.NumIterations += statistics.NumIterations;
+	totals.Seconds += statistics.Seconds;
+	totals.NumNodesCreated += statistics.NumNodesCreated;
+	totals.NumSearches++;
+}
+
+static void RunBudget(const PositionSet& positions, const std::string& budget, float timeToSolve, int32 iterationsToSolve, int32 numThreads)
+{
+	// the helpers of the solver, the calling thread is the first searching one
+	std::unique_ptr<ThreadPool> pool(numThreads > 1 ? new ThreadPool(numThreads - 1) : nullptr);
+	BudgetTotals totals;
+
+	for (const BenchmarkPosition& position : positions.GetPositions())
+	{
+		Solver solver(timeToSolve, iterationsToSolve, Options.Seed);
+		solver.SetThreadPool(pool.get(), numThreads);
+		solver.SetMemoryBudget(Options.MemoryMegabytes);
+		solver.SetUseSymmetry(Options.UseSymmetry);
+
+		std::vector<EStoneType> board = position.Board;
+		const int32 move = MoveSelection::GetMostVisited(solver.Run(board, position.Turn, -1));
+		PrintSearch(budget, numThreads, positions.GetVersion(), position, "first", move, solver.GetStatistics());
+		AddSearch(totals, solver.GetStatistics());
+
+		if(move == -1)
+		{
+			continue;
+		}
+
+		board[move] = position.Turn;
+		const EStoneType replyTurn = Solver::ChangeTurn(position.Turn);
+		const int32 reply = MoveSelection::GetMostVisited(solver.Run(board, replyTurn, move));
+		PrintSearch(budget, numThreads, positions.GetVersion(), position, "reply", reply, solver.GetStatistics());
+		AddSearch(totals, solver.GetStatistics());
+	}
+
+	const double iterationsPerSecond = totals.Seconds > 0 ? totals.NumIterations / totals.Seconds : 0;
+	std::printf("{\"summary\":true,\"positions_version\":%d,\"budget\":\"%s\",\"threads\":%d,\"searches\":%d,\"solved_searches\":%d,"
+		"\"iterations\":%lld,\"seconds\":%.6f,\"iterations_per_second\":%.1f,\"nodes_created\":%lld,\"peak_rss_kilobytes\":%ld}\n",
+		positions.GetVersion(), budget.c_str(), numThreads, totals.NumSearches, totals.NumSolvedSearches,
+		(long long)totals.NumIterations, totals.Seconds, iterationsPerSecond, (long long)totals.NumNodesCreated, GetPeakMemoryKilobytes());
+	std::fflush(stdout);
+}
+
+static bool ParseThreadCounts(const std::string& text, std::vector<int32>& outThreadCounts)
+{
+	outThreadCounts.clear();
+	std::istringstream counts(text);
+	std::string count;
+	while(std::getline(counts, count, ','))
+	{
+		const int32 numThreads = std::atoi(count.c_str());
+		if(numThreads < 1)
+		{
+			return false;
+		}
+		outThreadCounts.push_back(numThreads);
+	}
+	return !outThreadCounts.empty();
+}
+
+static bool ParseArguments(int argc, char** argv)
+{
+	for (int32 i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+		bool isValid = hasValue;
+
+		if(std::strcmp(argv[i], "--positions") == 0 && hasValue)
+		{
+			Options.PositionsPath = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--threads") == 0 && hasValue)
+		{
+			isValid = ParseThreadCounts(argv[++i], Options.ThreadCounts);
+		}
+		else if(std::strcmp(argv[i], "--iterations") == 0 && hasValue)
+		{
+			Options.Iterations = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--time") == 0 && hasValue)
+		{
+			Options.Time = (float)std::atof(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--memory") == 0 && hasValue)
+		{
+			Options.MemoryMegabytes = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--symmetry") == 0 && hasValue)
+		{
+			Options.UseSymmetry = std::atoi(argv[++i]) != 0;
+		}
+		else if(std::strcmp(argv[i], "--seed") == 0 && hasValue)
+		{
+			Options.Seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else
+		{
+			isValid = false;
+		}
+
+		if(!isValid)
+		{
+			std::fprintf(stderr, "usage: %s [--positions file] [--threads 1,2,4] [--iterations n] [--time seconds] "
+				"[--memory megabytes] [--symmetry 0|1] [--seed n]\n", argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if(!ParseArguments(argc, argv))
+	{
+		return 2;
+	}
+
+	PositionSet positions;
+	std::string error;
+	if(!positions.Load(Options.PositionsPath, error))
+	{
+		std::fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	for (const int32 numThreads : Options.ThreadCounts)
+	{
+		// a time of 0 is no limit, the iteration limit of the timed runs is never reached
+		RunBudget(positions, "iterations", 0, Options.Iterations, numThreads);
+		RunBudget(positions, "time", Options.Time, 1 << 30, numThreads);
+	}
+
+	return 0;
+}
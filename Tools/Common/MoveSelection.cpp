@@ -0,0 +1,16 @@
+#include "MoveSelection.h"
+
+int32 MoveSelection::GetMostVisited(const std::unordered_map<int32, Evaluation>& evaluations)
+{
+	int32 bestMove = -1;
+	int32 bestVisits = -1;
+	for (const auto& evaluation : evaluations)
+	{
+		if(evaluation.second.NumVisited > bestVisits || (evaluation.second.NumVisited == bestVisits && evaluation.first < bestMove))
+		{
+			bestMove = evaluation.first;
+			bestVisits = evaluation.second.NumVisited;
+		}
+	}
+	return bestMove;
+}
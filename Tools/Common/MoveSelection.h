@@ -0,0 +1,14 @@
+#pragma once
+
+#include <unordered_map>
+#include "Solver.h"
+
+class MoveSelection
+{
+
+public:
+
+	// the move with the most root visits like ABoard plays it, the lowest cell on ties, -1 for none
+	static int32 GetMostVisited(const std::unordered_map<int32, Evaluation>& evaluations);
+
+};
@@ -0,0 +1,52 @@
+#include "PositionText.h"
+#include <cmath>
+
+bool PositionText::ParseBoard(const std::string& text, std::vector<EStoneType>& outBoard)
+{
+	const int32 width = (int32)std::lround(std::sqrt((double)text.size()));
+	if(width == 0 || width * width != (int32)text.size() || width > MaxBoardWidth)
+	{
+		return false;
+	}
+
+	outBoard.resize(text.size());
+	for (int32 i = 0; i < (int32)text.size(); ++i)
+	{
+		if(!ParseStone(text[i], outBoard[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::string PositionText::FormatBoard(const std::vector<EStoneType>& board)
+{
+	std::string text(board.size(), '.');
+	for (int32 i = 0; i < (int32)board.size(); ++i)
+	{
+		text[i] = FormatStone(board[i]);
+	}
+	return text;
+}
+
+bool PositionText::ParseStone(char character, EStoneType& outStone)
+{
+	if(character == 'x' || character == 'o' || character == '.')
+	{
+		outStone = character == 'x' ? EStoneType::X : character == 'o' ? EStoneType::O : EStoneType::Empty;
+		return true;
+	}
+	
+	return false;
+}
+
+char PositionText::FormatStone(EStoneType stoneType)
+{
+	if(stoneType == EStoneType::X)
+	{
+		return 'x';
+	}
+	
+	return stoneType == EStoneType::O ? 'o' : '.';
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "BitBoard.h"
+
+/*
+ *  Text form of positions used by the tools. A board is written row by row with '.' for an
+ *  empty cell and 'x' and 'o' for the stones, so a 15x15 board is one word of 225 characters.
+ */
+class PositionText
+{
+
+public:
+
+	// false when text is not a square board of known characters
+	static bool ParseBoard(const std::string& text, std::vector<EStoneType>& outBoard);
+
+	static std::string FormatBoard(const std::vector<EStoneType>& board);
+
+	// false for anything but 'x', 'o' and '.'
+	static bool ParseStone(char character, EStoneType& outStone);
+
+	static char FormatStone(EStoneType stoneType);
+
+};
@@ -0,0 +1,34 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "PiskvorkEngine.h"
+
+/*
+ *  Command line engine for Piskvork and other Gomocup managers, reading commands from stdin
+ *  and answering on stdout.
+ *
+ *  pbrain-gomokuai [--threads n]
+ */
+int main(int argc, char** argv)
+{
+	int32 numThreads = 1;
+	for (int32 i = 1; i < argc; ++i)
+	{
+		if(std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			numThreads = std::atoi(argv[++i]);
+		}
+		else
+		{
+			std::cerr << "usage: " << argv[0] << " [--threads n]" << std::endl;
+			return 2;
+		}
+	}
+
+	// the managers talk to the engine through pipes, commands are answered as soon as they are read
+	std::ios::sync_with_stdio(false);
+
+	PiskvorkEngine engine(std::cin, std::cout, numThreads);
+	engine.Run();
+	return 0;
+}
@@ -0,0 +1,267 @@
+#include "PiskvorkEngine.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+#include "MoveSelection.h"
+
+PiskvorkEngine::PiskvorkEngine(std::istream& input, std::ostream& output, int32 numThreads) : Input(input), Output(output)
+{
+	NumThreads = FMath::Max(numThreads, 1);
+	Pool.reset(NumThreads > 1 ? new ThreadPool(NumThreads - 1) : nullptr);
+	SolverMemoryMegabytes = 0;
+	Width = 0;
+	LastMove = -1;
+	TimeoutTurn = DefaultTimeoutTurn;
+	TimeoutMatch = 0;
+	TimeLeft = 0;
+	MaxMemory = 0;
+}
+
+void PiskvorkEngine::Run()
+{
+	std::string line;
+	while(std::getline(Input, line))
+	{
+		line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+
+		const size_t separator = line.find(' ');
+		std::string command = line.substr(0, separator);
+		const std::string arguments = separator == std::string::npos ? "" : line.substr(separator + 1);
+		std::transform(command.begin(), command.end(), command.begin(), [](char character) { return (char)std::toupper(character); });
+
+		if(!command.empty() && !HandleCommand(command, arguments))
+		{
+			return;
+		}
+	}
+}
+
+bool PiskvorkEngine::HandleCommand(const std::string& command, const std::string& arguments)
+{
+	int32 index = -1;
+
+	if(command == "END")
+	{
+		return false;
+	}
+	
+	if(command == "START")
+	{
+		Start(std::atoi(arguments.c_str()));
+	}
+	else if(command == "RECTSTART")
+	{
+		WriteLine("ERROR only square boards are supported");
+	}
+	else if(command == "RESTART")
+	{
+		Start(Width);
+	}
+	else if(command == "INFO")
+	{
+		const size_t separator = arguments.find(' ');
+		SetInfo(arguments.substr(0, separator), separator == std::string::npos ? "" : arguments.substr(separator + 1));
+	}
+	else if(command == "ABOUT")
+	{
+		WriteLine("name=\"GomokuAI\", version=\"1.0\"");
+	}
+	else if(Board.empty())
+	{
+		WriteLine("ERROR no START yet");
+	}
+	else if(command == "BEGIN")
+	{
+		LastMove = -1;
+		PlayMove();
+	}
+	else if(command == "TURN")
+	{
+		if(!ParseCell(arguments, index) || Board[index] != EStoneType::Empty)
+		{
+			WriteLine("ERROR invalid move " + arguments);
+			return true;
+		}
+
+		Board[index] = EStoneType::O;
+		LastMove = index;
+		PlayMove();
+	}
+	else if(command == "BOARD")
+	{
+		ReadBoard();
+	}
+	else if(command == "TAKEBACK")
+	{
+		if(!ParseCell(arguments, index))
+		{
+			WriteLine("ERROR invalid move " + arguments);
+			return true;
+		}
+
+		Board[index] = EStoneType::Empty;
+		LastMove = -1;
+		WriteLine("OK");
+	}
+	else
+	{
+		WriteLine("UNKNOWN " + command);
+	}
+
+	return true;
+}
+
+void PiskvorkEngine::Start(int32 width)
+{
+	// a five has to fit on the board
+	if(width < 5 || width > MaxBoardWidth)
+	{
+		WriteLine("ERROR unsupported size");
+		return;
+	}
+
+	Width = width;
+	Board.assign(width * width, EStoneType::Empty);
+	LastMove = -1;
+
+	if(GameSolver == nullptr)
+	{
+		GameSolver.reset(new Solver(GetTimeForMove(), MaxIterationsPerMove));
+		GameSolver->SetThreadPool(Pool.get(), NumThreads);
+		GameSolver->SetUseSymmetry(true);
+	}
+
+	WriteLine("OK");
+}
+
+void PiskvorkEngine::ReadBoard()
+{
+	std::fill(Board.begin(), Board.end(), EStoneType::Empty);
+	LastMove = -1;
+
+	// x,y,field lines up to DONE, field 1 is our stone, 2 the opponent's and 3 a winning line of a continuous game
+	std::string line;
+	while(std::getline(Input, line))
+	{
+		line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+		if(line == "DONE")
+		{
+			PlayMove();
+			return;
+		}
+
+		const size_t separator = line.rfind(',');
+		int32 index;
+		if(separator == std::string::npos || !ParseCell(line.substr(0, separator), index))
+		{
+			continue;
+		}
+
+		const int32 field = std::atoi(line.c_str() + separator + 1);
+		Board[index] = field == 1 ? EStoneType::X : EStoneType::O;
+	}
+}
+
+void PiskvorkEngine::SetInfo(const std::string& key, const std::string& value)
+{
+	if(key == "timeout_turn")
+	{
+		TimeoutTurn = std::atoll(value.c_str());
+	}
+	else if(key == "timeout_match")
+	{
+		TimeoutMatch = std::atoll(value.c_str());
+	}
+	else if(key == "time_left")
+	{
+		TimeLeft = std::atoll(value.c_str());
+	}
+	else if(key == "max_memory")
+	{
+		MaxMemory = std::atoll(value.c_str());
+	}
+	else if(key == "rule" && (std::atoi(value.c_str()) & ~2) != 0)
+	{
+		// only the continuous game bit changes nothing for us
+		WriteLine("MESSAGE only the free-style rule is supported, playing free-style");
+	}
+}
+
+void PiskvorkEngine::PlayMove()
+{
+	if(std::find(Board.begin(), Board.end(), EStoneType::Empty) == Board.end())
+	{
+		WriteLine("ERROR the board is full");
+		return;
+	}
+
+	// managers send max_memory after START as well, so the memory is checked before every search.
+	// The solver sizes its tables with the next search
+	const int32 memoryMegabytes = GetMemoryMegabytes();
+	if(memoryMegabytes != SolverMemoryMegabytes)
+	{
+		GameSolver->SetMemoryBudget(memoryMegabytes);
+		SolverMemoryMegabytes = memoryMegabytes;
+	}
+
+	GameSolver->SetBudget(GetTimeForMove(), MaxIterationsPerMove);
+	int32 move = MoveSelection::GetMostVisited(GameSolver->Run(Board, EStoneType::X, LastMove));
+
+	// an empty board has nothing to search around
+	if(move == -1 || Board[move] != EStoneType::Empty)
+	{
+		move = BitBoard::FlattenIndex(Width / 2, Width / 2, Width);
+		while(Board[move] != EStoneType::Empty)
+		{
+			move = (move + 1) % (int32)Board.size();
+		}
+	}
+
+	Board[move] = EStoneType::X;
+	LastMove = move;
+	WriteLine(std::to_string(move % Width) + "," + std::to_string(move / Width));
+}
+
+float PiskvorkEngine::GetTimeForMove() const
+{
+	float time = TimeoutTurn > 0 ? TimeoutTurn / 1000.0f : FastMoveTime;
+
+	if(TimeoutMatch > 0 && TimeLeft > 0)
+	{
+		time = FMath::Min(time, TimeLeft / 1000.0f / MovesToGo);
+	}
+
+	// 0 would be no limit for the solver
+	return FMath::Max(time - MoveOverhead, 0.001f);
+}
+
+int32 PiskvorkEngine::GetMemoryMegabytes() const
+{
+	if(MaxMemory <= 0)
+	{
+		return DefaultMemoryMegabytes;
+	}
+	
+	return FMath::Max((int32)((MaxMemory >> 20) - ProcessMemoryMegabytes) * 3 / 4, 1);
+}
+
+bool PiskvorkEngine::ParseCell(const std::string& text, int32& outIndex) const
+{
+	std::istringstream cell(text);
+	int32 x;
+	int32 y;
+	char comma;
+	if(!(cell >> x >> comma >> y) || comma != ',' || x < 0 || x >= Width || y < 0 || y >= Width)
+	{
+		return false;
+	}
+
+	outIndex = BitBoard::FlattenIndex(x, y, Width);
+	return true;
+}
+
+void PiskvorkEngine::WriteLine(const std::string& line)
+{
+	Output << line << std::endl;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Solver.h"
+#include "ThreadPool.h"
+
+/*
+ *  The Piskvork (Gomocup) text protocol on top of one solver. Commands are read line by line
+ *  and every answer is one line.
+ *  Our stones are X and the opponent's O whoever started, the rules are the same for both.
+ *  The solver keeps its tree between TURN commands, BOARD and TAKEBACK start a new one.
+ */
+class PiskvorkEngine
+{
+
+public:
+
+	PiskvorkEngine(std::istream& input, std::ostream& output, int32 numThreads);
+
+public:
+
+	// answers commands until END or the end of input
+	void Run();
+
+private:
+
+	// false for END
+	bool HandleCommand(const std::string& command, const std::string& arguments);
+
+	void Start(int32 width);
+
+	void ReadBoard();
+
+	void SetInfo(const std::string& key, const std::string& value);
+
+	// searches, plays and writes our move
+	void PlayMove();
+
+	float GetTimeForMove() const;
+
+	// the solver memory which keeps the process within max_memory
+	int32 GetMemoryMegabytes() const;
+
+	// "x,y" to a cell index, false when it is not on the board
+	bool ParseCell(const std::string& text, int32& outIndex) const;
+
+	void WriteLine(const std::string& line);
+
+private:
+
+	std::istream& Input;
+
+	std::ostream& Output;
+
+	int32 NumThreads;
+
+	std::unique_ptr<ThreadPool> Pool;
+
+	std::unique_ptr<Solver> GameSolver;
+
+	// the memory the solver was given, 0 before the first search
+	int32 SolverMemoryMegabytes;
+
+	std::vector<EStoneType> Board;
+
+	int32 Width;
+
+	// the opponent's move the solver's tree can follow, -1 when the tree has to start over
+	int32 LastMove;
+
+	// milliseconds, see SetInfo
+	int64 TimeoutTurn;
+
+	int64 TimeoutMatch;
+
+	int64 TimeLeft;
+
+	// bytes, 0 for no limit
+	int64 MaxMemory;
+
+	static constexpr int64 DefaultTimeoutTurn = 5000;
+
+	// timeout_turn 0 asks for moves as fast as possible
+	static constexpr float FastMoveTime = 0.05f;
+
+	// time for reading the command and writing the answer, taken off every move
+	static constexpr float MoveOverhead = 0.03f;
+
+	// the rest of the match time is spread over this many of our moves
+	static constexpr int32 MovesToGo = 20;
+
+	// no limit of its own, GetTimeForMove always gives a time which ends the search
+	static constexpr int32 MaxIterationsPerMove = 1 << 30;
+
+	static constexpr int32 DefaultMemoryMegabytes = 256;
+
+	// memory of the process besides the solver. The solver only counts what it asks the arenas for,
+	// so it is given three quarters of the rest of max_memory to leave room for what it does not see
+	static constexpr int32 ProcessMemoryMegabytes = 16;
+
+};
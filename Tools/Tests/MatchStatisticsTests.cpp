@@ -0,0 +1,59 @@
+#include "MatchStatistics.h"
+#include "TestSupport.h"
+
+/*
+ *  The test of a match has to end when one engine wins every game, although the scores have no
+ *  spread then, and has to go on while the results do not decide between the hypotheses.
+ */
+
+static void TestAllWinsAcceptH1()
+{
+	MatchStatistics statistics(0, 10, 0.05f, 0.05f);
+	TEST_CHECK(statistics.GetLlr() == 0);
+
+	int32 numGames = 0;
+	for (; numGames < 1000 && statistics.GetResult() == ESprtResult::Continue; ++numGames)
+	{
+		statistics.AddResult(1);
+	}
+
+	TEST_CHECK(statistics.GetResult() == ESprtResult::AcceptH1);
+	TEST_CHECK(statistics.GetLlr() >= statistics.GetUpperBound());
+	std::printf("all wins accepted H1 after %d games\n", numGames);
+}
+
+static void TestAllLossesAcceptH0()
+{
+	MatchStatistics statistics(0, 10, 0.05f, 0.05f);
+
+	for (int32 numGames = 0; numGames < 1000 && statistics.GetResult() == ESprtResult::Continue; ++numGames)
+	{
+		statistics.AddResult(0);
+	}
+
+	TEST_CHECK(statistics.GetResult() == ESprtResult::AcceptH0);
+	TEST_CHECK(statistics.GetLlr() <= statistics.GetLowerBound());
+}
+
+static void TestEvenResultsContinue()
+{
+	// a score halfway between the hypotheses is evidence for neither
+	MatchStatistics statistics(-10, 10, 0.05f, 0.05f);
+
+	for (int32 numGames = 0; numGames < 100; ++numGames)
+	{
+		statistics.AddResult(numGames % 2 == 0 ? 1.0f : 0.0f);
+		statistics.AddResult(0.5f);
+	}
+
+	TEST_CHECK(statistics.GetResult() == ESprtResult::Continue);
+}
+
+int main()
+{
+	TestAllWinsAcceptH1();
+	TestAllLossesAcceptH0();
+	TestEvenResultsContinue();
+
+	return TestSupport::Finish("MatchStatisticsTests");
+}
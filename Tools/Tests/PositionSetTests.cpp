@@ -0,0 +1,49 @@
+#include "PositionSet.h"
+#include "TestSupport.h"
+
+/*
+ *  The benchmark positions have to stay quiet, a position Solver answers before its tree search
+ *  measures nothing of the search. GeneratePositions writes positions which pass.
+ */
+
+static void TestBenchmarkPositionsAreQuiet()
+{
+	PositionSet positions;
+	std::string error;
+	if(!TEST_CHECK(positions.Load(GOMOKU_BENCHMARK_POSITIONS, error)))
+	{
+		std::printf("%s\n", error.c_str());
+		return;
+	}
+
+	for (const BenchmarkPosition& position : positions.GetPositions())
+	{
+		std::string reason;
+		if(!TEST_CHECK(PositionSet::IsQuiet(position.Board, position.Turn, reason)))
+		{
+			std::printf("%s is not quiet: %s\n", position.Name.c_str(), reason.c_str());
+		}
+	}
+}
+
+static void TestLoudPositionsAreFound()
+{
+	std::string reason;
+
+	// X to move makes a closed four
+	TEST_CHECK(!PositionSet::IsQuiet(TestSupport::GetClosedFourPosition(), EStoneType::X, reason));
+
+	// O to move has no four to make, but X already has one
+	std::vector<EStoneType> board = TestSupport::GetClosedFourPosition();
+	board[BitBoard::FlattenIndex(8, 7, 15)] = EStoneType::X;
+	TEST_CHECK(!PositionSet::IsQuiet(board, EStoneType::O, reason));
+	TEST_CHECK(reason == "x has a four");
+}
+
+int main()
+{
+	TestBenchmarkPositionsAreQuiet();
+	TestLoudPositionsAreFound();
+
+	return TestSupport::Finish("PositionSetTests");
+}
@@ -0,0 +1,100 @@
+#include "ProofNumberSearch.h"
+#include "TestSupport.h"
+#include "ThreatSearch.h"
+
+/*
+ *  ProofNumberSearch only proves wins which end in a five, so it has to agree with ThreatSearch:
+ *  no proof where FindWin finds no win and no disproof where it finds one.
+ *  With far more nodes than Solver gives it, it also proves wins by threes deeper than FindWin looks.
+ */
+
+// X X . X with room on both sides and X at (7, 5) and (7, 6) above the gap, X at (7, 7)
+// makes an open four on row 7 and an open three on column 7 at once
+static std::vector<EStoneType> GetFourThreePosition()
+{
+	return TestSupport::ParseRows({
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		".......x.......",
+		".......x.......",
+		".....xx.x......",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"o.............o",
+		"...............",
+		"o.............o",
+	});
+}
+
+static void TestClosedFourIsNotProven()
+{
+	ProofNumberSearch proofs(1);
+	const EProofResult result = proofs.Solve(BitBoard(TestSupport::GetClosedFourPosition()), EStoneType::X, 0, 0);
+
+	TEST_CHECK(result == EProofResult::Disproven);
+	TEST_CHECK(proofs.GetProofNumber() != 0);
+	TEST_CHECK(proofs.GetBestMove() == -1);
+}
+
+static void TestFourThreeIsProven()
+{
+	ProofNumberSearch proofs(1);
+	TEST_CHECK(proofs.Solve(BitBoard(GetFourThreePosition()), EStoneType::X, 0, 0) == EProofResult::Proven);
+	TEST_CHECK(proofs.GetBestMove() == BitBoard::FlattenIndex(7, 7, 15));
+
+	// the other side has nothing to attack with
+	TEST_CHECK(proofs.Solve(BitBoard(GetFourThreePosition()), EStoneType::O, 0, 0) == EProofResult::Disproven);
+}
+
+static void TestAgreesWithThreatSearch()
+{
+	std::mt19937 random(11);
+	ProofNumberSearch proofs(4);
+	int32 numProven = 0;
+	int32 numDisproven = 0;
+
+	for (int32 position = 0; position < 100; ++position)
+	{
+		BitBoard board;
+		EStoneType turn;
+		if(!TestSupport::MakeRandomPosition(random, 15, 10 + position % 16, board, turn))
+		{
+			continue;
+		}
+
+		ThreatSearch threats(0, 0);
+		std::vector<int32> line;
+		const bool isWin = threats.FindWin(board, turn, line);
+
+		// the budget Solver gives it
+		const EProofResult result = proofs.Solve(board, turn, 2000, 0);
+
+		if(result == EProofResult::Proven)
+		{
+			numProven++;
+			TEST_CHECK(isWin);
+		}
+		else if(result == EProofResult::Disproven)
+		{
+			numDisproven++;
+			TEST_CHECK(!isWin);
+		}
+	}
+
+	std::printf("%d proven and %d disproven positions checked\n", numProven, numDisproven);
+	TEST_CHECK(numProven >= 20 && numDisproven >= 20);
+}
+
+int main()
+{
+	TestClosedFourIsNotProven();
+	TestFourThreeIsProven();
+	TestAgreesWithThreatSearch();
+
+	return TestSupport::Finish("ProofNumberSearchTests");
+}
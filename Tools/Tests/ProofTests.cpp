@@ -0,0 +1,156 @@
+#include "BoardState.h"
+#include "MoveSelection.h"
+#include "Solver.h"
+#include "TestSupport.h"
+
+/*
+ *  The proofs BoardState::Expand marks leaves with, and what Run reports for them.
+ *  A proof is only set for a five, an open four or a double four, other fours stay ordinary leaves.
+ */
+
+// X X X with room on both sides, X to move makes an open four at (4, 7) or (8, 7)
+static std::vector<EStoneType> GetOpenFourPosition()
+{
+	return TestSupport::ParseRows({
+		"o..............",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		".....xxx.......",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"o.............o",
+	});
+}
+
+// X X X . on row 7 closed by O on the left and X X X . on column 9 closed by O at the top,
+// X at (9, 7) makes two closed fours at once
+static std::vector<EStoneType> GetDoubleFourPosition()
+{
+	return TestSupport::ParseRows({
+		"...............",
+		"...............",
+		"...............",
+		".........o.....",
+		".........x.....",
+		".........x.....",
+		".........x.....",
+		".....oxxx......",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"o.............o",
+		"...............",
+	});
+}
+
+// X X X on row 12 with one free cell on each side and O behind the right one, and X X meeting
+// X X at (7, 7). O to move only keeps the blocks of the closed three, after either of them X plays
+// (7, 7) with two open threes. O at (7, 7) takes the double three away, so O is not lost
+static std::vector<EStoneType> GetClosedThreePosition()
+{
+	return TestSupport::ParseRows({
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		".......x.......",
+		".......x.......",
+		".....xx........",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		".xxx.o.........",
+		"...............",
+		"o.............o",
+	});
+}
+
+static void Expand(BoardState& state)
+{
+	MoveList actions;
+	state.Expand(actions);
+}
+
+static void TestClosedFourIsNotProven()
+{
+	const BitBoard board(TestSupport::GetClosedFourPosition());
+	TEST_CHECK(!BoardState::IsWinningFour(board, BitBoard::FlattenIndex(4, 7, 15), EStoneType::X));
+	TEST_CHECK(!BoardState::IsWinningFour(board, BitBoard::FlattenIndex(8, 7, 15), EStoneType::X));
+
+	BoardState state(BitBoard(TestSupport::GetClosedFourPosition()), EStoneType::X);
+	Expand(state);
+	TEST_CHECK(!state.IsProven());
+}
+
+static void TestClosedFourIsNotDecisiveInRun()
+{
+	std::vector<EStoneType> board = TestSupport::GetClosedFourPosition();
+	Solver solver(0, 2000, 1);
+	const std::unordered_map<int32, Evaluation> evaluations = solver.Run(board, EStoneType::X, -1);
+
+	TEST_CHECK(!evaluations.empty());
+	for (const auto& evaluation : evaluations)
+	{
+		TEST_CHECK(evaluation.second.NumVisited < 1000000);
+	}
+}
+
+static void TestOpenFourIsProven()
+{
+	TEST_CHECK(BoardState::IsWinningFour(BitBoard(GetOpenFourPosition()), BitBoard::FlattenIndex(4, 7, 15), EStoneType::X));
+
+	BoardState state(BitBoard(GetOpenFourPosition()), EStoneType::X);
+	Expand(state);
+	TEST_CHECK(state.Proof.load() == EProofState::Loss);
+
+	const int32 move = state.DecisiveMoveIndex;
+	TEST_CHECK(move == BitBoard::FlattenIndex(4, 7, 15) || move == BitBoard::FlattenIndex(8, 7, 15));
+}
+
+static void TestDoubleFourIsProven()
+{
+	const int32 move = BitBoard::FlattenIndex(9, 7, 15);
+	TEST_CHECK(BoardState::IsWinningFour(BitBoard(GetDoubleFourPosition()), move, EStoneType::X));
+
+	BoardState state(BitBoard(GetDoubleFourPosition()), EStoneType::X);
+	Expand(state);
+	TEST_CHECK(state.Proof.load() == EProofState::Loss);
+	TEST_CHECK(state.DecisiveMoveIndex == move);
+}
+
+static void TestPrunedStateIsNotLost()
+{
+	BoardState state(BitBoard(GetClosedThreePosition()), EStoneType::O);
+	MoveList actions;
+	state.Expand(actions);
+	TEST_CHECK(actions.Num == 2 && !state.HasAllChildren);
+
+	// every block the tree keeps loses to the double three, which once proved O lost
+	std::vector<EStoneType> board = GetClosedThreePosition();
+	Solver solver(0, 5000, 1);
+	solver.Run(board, EStoneType::O, -1);
+	TEST_CHECK(!solver.GetStatistics().IsRootSolved);
+}
+
+int main()
+{
+	TestClosedFourIsNotProven();
+	TestClosedFourIsNotDecisiveInRun();
+	TestOpenFourIsProven();
+	TestDoubleFourIsProven();
+	TestPrunedStateIsNotLost();
+
+	return TestSupport::Finish("ProofTests");
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "BoardState.h"
+#include "PositionText.h"
+
+/*
+ *  The little the test programs share: checks which report a failure and let the program go on,
+ *  boards written as rows of the PositionText characters and random positions.
+ */
+class TestSupport
+{
+
+public:
+
+	static bool Check(bool condition, const char* text, const char* file, int32 line)
+	{
+		if(!condition)
+		{
+			std::printf("%s:%d: check failed: %s\n", file, line, text);
+			GetNumFailures()++;
+		}
+		return condition;
+	}
+
+	// the exit code of the test program
+	static int32 Finish(const char* name)
+	{
+		std::printf("%s: %s, %d failed checks\n", name, GetNumFailures() == 0 ? "passed" : "FAILED", GetNumFailures());
+		return GetNumFailures() == 0 ? 0 : 1;
+	}
+
+	// rows from top to bottom, they have to form a square board
+	static std::vector<EStoneType> ParseRows(const std::vector<std::string>& rows)
+	{
+		std::string text;
+		for (const std::string& row : rows)
+		{
+			text += row;
+		}
+
+		std::vector<EStoneType> board;
+		if(!PositionText::ParseBoard(text, board))
+		{
+			std::printf("not a board: %s\n", text.c_str());
+			GetNumFailures()++;
+		}
+		return board;
+	}
+
+	// O . X X X . O on row 7 and an O at (7, 1), X to move. X can make a four at (4, 7) or (8, 7)
+	// but both are closed by an O, so it is no win
+	static std::vector<EStoneType> GetClosedFourPosition()
+	{
+		return ParseRows({
+			"...............",
+			".......o.......",
+			"...............",
+			"...............",
+			"...............",
+			"...............",
+			"...............",
+			"...o.xxx.o.....",
+			"...............",
+			"...............",
+			"...............",
+			"...............",
+			"...............",
+			"...............",
+			"...............",
+		});
+	}
+
+	// up to numStones random moves of alternating sides around the centre, so lines form often.
+	// False when a side made five, outTurn is the side to move after the last stone
+	static bool MakeRandomPosition(std::mt19937& random, int32 width, int32 numStones, BitBoard& outBoard, EStoneType& outTurn)
+	{
+		std::uniform_int_distribution<int32> offset(-4, 4);
+		outBoard = BitBoard(width);
+		outTurn = EStoneType::X;
+
+		for (int32 i = 0; i < numStones; ++i)
+		{
+			const int32 move = BitBoard::FlattenIndex(width / 2 + offset(random), width / 2 + offset(random), width);
+			if(!outBoard.IsEmpty(move))
+			{
+				continue;
+			}
+
+			outBoard.Set(move, outTurn);
+			if(BoardState::FindSequence(outBoard, move, outTurn, 5))
+			{
+				return false;
+			}
+			outTurn = outTurn == EStoneType::X ? EStoneType::O : EStoneType::X;
+		}
+		return true;
+	}
+
+private:
+
+	static int32& GetNumFailures()
+	{
+		static int32 numFailures = 0;
+		return numFailures;
+	}
+
+};
+
+#define TEST_CHECK(condition) TestSupport::Check((condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,154 @@
+#include "BoardState.h"
+#include "TestSupport.h"
+#include "ThreatSearch.h"
+
+/*
+ *  Wins ThreatSearch has to find, positions it must not call a win, and a check over random
+ *  positions that every found win survives all replies of the defender.
+ */
+
+// X at (8, 7) makes a closed four on row 7 and O has to take (9, 7), then X at (11, 4) makes
+// two fours on column 11 and the diagonal through (8, 7). The other order wins as well
+static std::vector<EStoneType> GetContinuousFourPosition()
+{
+	return TestSupport::ParseRows({
+		"...............",
+		"...............",
+		"...............",
+		"............o..",
+		"...............",
+		"..........xx...",
+		".........x.x...",
+		"....oxxx...x...",
+		"...........o...",
+		"...............",
+		"...............",
+		"...............",
+		"o.............o",
+		"...............",
+		"...............",
+	});
+}
+
+// X at (8, 7) makes two open threes on row 7 and column 8, which no fours can win
+static std::vector<EStoneType> GetDoubleThreePosition()
+{
+	return TestSupport::ParseRows({
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"........x......",
+		"........x......",
+		"......xx.......",
+		"...............",
+		"...............",
+		"...............",
+		"...............",
+		"o.............o",
+		"...............",
+		"o.............o",
+	});
+}
+
+static void TestContinuousFours()
+{
+	const BitBoard board(GetContinuousFourPosition());
+	ThreatSearch search(0, 0);
+	std::vector<int32> line;
+
+	TEST_CHECK(search.Search(board, EStoneType::X, false, ThreatSearch::MaxFourDepth, line));
+	TEST_CHECK(line.size() == 5);
+	TEST_CHECK(!line.empty() && (line[0] == BitBoard::FlattenIndex(8, 7, 15) || line[0] == BitBoard::FlattenIndex(11, 4, 15)));
+}
+
+static void TestDoubleThree()
+{
+	const BitBoard board(GetDoubleThreePosition());
+	ThreatSearch search(0, 0);
+	std::vector<int32> line;
+
+	TEST_CHECK(!search.Search(board, EStoneType::X, false, ThreatSearch::MaxFourDepth, line));
+	TEST_CHECK(search.FindWin(board, EStoneType::X, line));
+	TEST_CHECK(!line.empty() && line[0] == BitBoard::FlattenIndex(8, 7, 15));
+}
+
+static void TestClosedFourIsNoWin()
+{
+	const BitBoard board(TestSupport::GetClosedFourPosition());
+	ThreatSearch search(0, 0);
+	std::vector<int32> line;
+
+	TEST_CHECK(!search.FindWin(board, EStoneType::X, line));
+	TEST_CHECK(line.empty());
+}
+
+// the defender to move after the first move of a win, every reply has to leave a win
+static bool IsRefuted(BitBoard board, EStoneType attacker, int32 move)
+{
+	const EStoneType defender = attacker == EStoneType::X ? EStoneType::O : EStoneType::X;
+	board.Set(move, attacker);
+	if(BoardState::FindSequence(board, move, attacker, 5))
+	{
+		return false;
+	}
+
+	// a cell further away from every stone neither blocks a line nor makes a four
+	ThreatSearch search(0, 0);
+	const MoveList replies = MoveList::FromMask(board.GetNeighbourhood());
+	for (int32 i = 0; i < replies.Num; ++i)
+	{
+		const int32 reply = replies.Moves[i];
+		board.Set(reply, defender);
+		std::vector<int32> line;
+		const bool isWin = !BoardState::FindSequence(board, reply, defender, 5) && search.FindWin(board, attacker, line);
+		board.Set(reply, EStoneType::Empty);
+
+		if(!isWin)
+		{
+			std::printf("the win starting at %d is refuted by %d\n", move, reply);
+			return true;
+		}
+	}
+	return false;
+}
+
+static void TestFoundWinsHold()
+{
+	std::mt19937 random(7);
+	int32 numWins = 0;
+
+	for (int32 position = 0; position < 100; ++position)
+	{
+		BitBoard board;
+		EStoneType turn;
+		if(!TestSupport::MakeRandomPosition(random, 15, 10 + position % 16, board, turn))
+		{
+			continue;
+		}
+
+		// the budget Solver uses, the replies below are searched without one
+		ThreatSearch search(20000, 0);
+		std::vector<int32> line;
+		if(search.FindWin(board, turn, line))
+		{
+			numWins++;
+			TEST_CHECK(!line.empty() && !IsRefuted(board, turn, line[0]));
+		}
+	}
+
+	// the positions have to exercise the search at all
+	std::printf("%d found wins checked\n", numWins);
+	TEST_CHECK(numWins >= 20);
+}
+
+int main()
+{
+	TestContinuousFours();
+	TestDoubleThree();
+	TestClosedFourIsNoWin();
+	TestFoundWinsHold();
+
+	return TestSupport::Finish("ThreatSearchTests");
+}